@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeAIController.h"
+
+#include "SlimeCharacter.h"
+#include "Surface/SurfaceNavSubsystem.h"
+
+#include "InputActionValue.h"
+
+ASlimeAIController::ASlimeAIController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+void ASlimeAIController::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ASlimeCharacter* Slime = Cast<ASlimeCharacter>(GetPawn());
+	if (!Slime || !HasGoal) return;
+
+	if (GoalActor.IsValid())
+	{
+		GoalLocation = GoalActor->GetActorLocation();
+	}
+
+	//Failed queries wait out the interval too rather than retrying every frame
+	TimeSinceRepath += DeltaTime;
+	if (!IsPathPending && TimeSinceRepath >= RepathInterval)
+	{
+		RequestPath(Slime);
+	}
+
+	FollowPath(Slime);
+}
+
+void ASlimeAIController::MoveToSurfaceLocation(const FVector& Location)
+{
+	GoalActor = nullptr;
+	GoalLocation = Location;
+	HasGoal = true;
+
+	//Ask again on the next tick
+	TimeSinceRepath = RepathInterval;
+}
+
+void ASlimeAIController::FollowActor(AActor* Actor)
+{
+	if (!Actor) return;
+
+	MoveToSurfaceLocation(Actor->GetActorLocation());
+	GoalActor = Actor;
+}
+
+void ASlimeAIController::StopSurfaceMove()
+{
+	GoalActor = nullptr;
+	HasGoal = false;
+	Path.Points.Reset();
+	PathIndex = 0;
+}
+
+bool ASlimeAIController::IsFollowingPath() const
+{
+	return HasGoal && Path.Points.IsValidIndex(PathIndex);
+}
+
+void ASlimeAIController::RequestPath(const ASlimeCharacter* Slime)
+{
+	const USurfaceNavSubsystem* SurfaceNav = GetWorld()->GetSubsystem<USurfaceNavSubsystem>();
+	if (!SurfaceNav) return;
+
+	IsPathPending = true;
+	TimeSinceRepath = 0.0f;
+
+	SurfaceNav->FindPathAsync(Slime->GetActorLocation(), GoalLocation, FOnSurfacePathFound::CreateUObject(this, &ASlimeAIController::OnPathFound));
+}
+
+void ASlimeAIController::OnPathFound(const FSurfaceNavPath& NewPath)
+{
+	IsPathPending = false;
+	if (!HasGoal) return;
+
+	//Keep following the old path rather than stopping when a repath fails
+	if (!NewPath.IsValid() && Path.IsValid()) return;
+
+	Path = NewPath;
+	PathIndex = 0;
+}
+
+void ASlimeAIController::FollowPath(ASlimeCharacter* Slime)
+{
+	if (!Path.Points.IsValidIndex(PathIndex)) return;
+
+	const FVector Up = Slime->GetActorUpVector();
+	const FVector ToPoint = FVector::VectorPlaneProject(Path.Points[PathIndex].Location - Slime->GetActorLocation(), Up);
+
+	if (ToPoint.Size() > AcceptanceRadius)
+	{
+		MoveTowards(Slime, ToPoint.GetSafeNormal());
+		return;
+	}
+
+	++PathIndex;
+	if (!Path.Points.IsValidIndex(PathIndex))
+	{
+		HasGoal = GoalActor.IsValid();
+		return;
+	}
+
+	//Jump points are reached by launching from the one before
+	if (Path.Points[PathIndex].Link == ESurfaceNavLink::Jump)
+	{
+		JumpTowards(Slime, Path.Points[PathIndex].Location);
+	}
+}
+
+void ASlimeAIController::MoveTowards(ASlimeCharacter* Slime, const FVector& Direction)
+{
+	if (Slime->IsInState<ClimbingState>())
+	{
+		FVector AxisX, AxisY;
+		Slime->GetWallMovementAxes(AxisX, AxisY);
+
+		Slime->OnWallMove(FInputActionValue(FVector2D(Direction | AxisX, Direction | AxisY)));
+		return;
+	}
+
+	//Move is relative to the control rotation's yaw, the same way a player's stick is
+	const FRotator YawRotation(0.0, GetControlRotation().Yaw, 0.0);
+	const FVector Forward = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::X);
+	const FVector Right = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::Y);
+
+	Slime->Move(FInputActionValue(FVector2D(Direction | Right, Direction | Forward)));
+}
+
+void ASlimeAIController::JumpTowards(ASlimeCharacter* Slime, const FVector& Landing)
+{
+	//Same states the jump input is bound in
+	if (!Slime->IsInState<DefaultState>() && !Slime->IsInState<ClimbingState>()) return;
+
+	const FVector Up = Slime->GetActorUpVector();
+	const FVector Offset = FVector::VectorPlaneProject(Landing - Slime->GetActorLocation(), Up);
+
+	//Launches go up and forward equally, so charge for a 45 degree arc over the gap, within what a held ChargeJump reaches
+	const double Gravity = FMath::Abs(Slime->GetCharacterMovement()->GetGravityZ());
+	const double Speed = FMath::Clamp(FMath::Sqrt(Gravity * Offset.Size() * 0.5), SlimeCharge::MinJumpVelocity, SlimeCharge::MaxJumpVelocity);
+
+	Slime->SetActorRotation(FRotationMatrix::MakeFromXZ(Offset, Up).Rotator());
+	Slime->SetJumpVelocity(FVector(Speed));
+	Slime->Jump(FInputActionValue());
+}
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+
+#include "Surface/SurfaceNavGraph.h"
+
+#include "SlimeAIController.generated.h"
+
+class ASlimeCharacter;
+
+// Walks a slime along surface navigation paths, driving it through the same
+// Move, OnWallMove and Jump callbacks player input goes through
+UCLASS()
+class UE_SOLO_PROJECT_API ASlimeAIController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	// How close the slime has to get to a path point before moving on to the next
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Navigation")
+	float AcceptanceRadius = 75.0f;
+
+	// Seconds between path queries while following a goal
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Navigation")
+	float RepathInterval = 1.0f;
+
+private:
+	TWeakObjectPtr<AActor> GoalActor;
+	FVector GoalLocation = FVector::ZeroVector;
+	bool HasGoal = false;
+
+	FSurfaceNavPath Path;
+	int32 PathIndex = 0;
+
+	bool IsPathPending = false;
+	float TimeSinceRepath = 0.0f;
+
+public:
+	ASlimeAIController();
+
+	virtual void Tick(float DeltaTime) override;
+
+	UFUNCTION(BlueprintCallable, Category = "Surface Navigation")
+	void MoveToSurfaceLocation(const FVector& Location);
+
+	UFUNCTION(BlueprintCallable, Category = "Surface Navigation")
+	void FollowActor(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category = "Surface Navigation")
+	void StopSurfaceMove();
+
+	UFUNCTION(BlueprintPure, Category = "Surface Navigation")
+	bool IsFollowingPath() const;
+
+private:
+	void RequestPath(const ASlimeCharacter* Slime);
+
+	void OnPathFound(const FSurfaceNavPath& NewPath);
+
+	void FollowPath(ASlimeCharacter* Slime);
+
+	void MoveTowards(ASlimeCharacter* Slime, const FVector& Direction);
+
+	void JumpTowards(ASlimeCharacter* Slime, const FVector& Landing);
+};
@@ -0,0 +1,255 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeBenchmark.h"
+
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/CollisionProfile.h"
+#include "Components/StaticMeshComponent.h"
+
+#include "InputActionValue.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+ASlimeBenchmark::ASlimeBenchmark()
+{
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+void ASlimeBenchmark::BeginPlay()
+{
+	Super::BeginPlay();
+
+	BuildTestLevel();
+	SpawnSlimes();
+}
+
+void ASlimeBenchmark::BuildTestLevel()
+{
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!CubeMesh) return;
+
+	const FVector Origin = GetActorLocation();
+	const float CourseWidth = NumSlimes * LaneSpacing;
+
+	//Shared floor under every lane
+	SpawnBlock(CubeMesh, Origin + FVector(500.0f, CourseWidth / 2.0f, -50.0f), FVector(3000.0f, CourseWidth + 1000.0f, 100.0f));
+
+	for (int32 Lane = 0; Lane < NumSlimes; ++Lane)
+	{
+		const FVector LaneOrigin = Origin + FVector(0.0f, Lane * LaneSpacing, 0.0f);
+
+		//Wall to climb
+		SpawnBlock(CubeMesh, LaneOrigin + FVector(1000.0f, 0.0f, 300.0f), FVector(50.0f, 300.0f, 600.0f));
+
+		//Ledge on top of the wall, overhanging the lane to exercise the up and wrap around probes
+		SpawnBlock(CubeMesh, LaneOrigin + FVector(900.0f, 0.0f, 625.0f), FVector(250.0f, 300.0f, 50.0f));
+	}
+}
+
+void ASlimeBenchmark::SpawnBlock(UStaticMesh* Mesh, const FVector& Location, const FVector& Size)
+{
+	AStaticMeshActor* Block = GetWorld()->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+	if (!Block) return;
+
+	UStaticMeshComponent* MeshComponent = Block->GetStaticMeshComponent();
+	MeshComponent->SetMobility(EComponentMobility::Movable);
+	MeshComponent->SetStaticMesh(Mesh);
+	MeshComponent->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	MeshComponent->SetCollisionResponseToChannel(ECC_GameTraceChannel1, ECR_Block);
+
+	//The engine cube is 100 units on each side
+	Block->SetActorScale3D(Size / 100.0f);
+}
+
+void ASlimeBenchmark::SpawnSlimes()
+{
+	UClass* Class = SlimeClass ? SlimeClass.Get() : ASlimeCharacter::StaticClass();
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	for (int32 Lane = 0; Lane < NumSlimes; ++Lane)
+	{
+		const FVector Location = GetActorLocation() + FVector(0.0f, Lane * LaneSpacing, 100.0f);
+
+		ASlimeCharacter* Slime = GetWorld()->SpawnActor<ASlimeCharacter>(Class, Location, FRotator::ZeroRotator, SpawnParameters);
+		if (!Slime) continue;
+
+		Slime->SpawnDefaultController();
+
+		//Stagger the jumps so transitions are spread across frames
+		FBenchmarkSlime& BenchmarkSlime = Slimes.AddDefaulted_GetRef();
+		BenchmarkSlime.Slime = Slime;
+		BenchmarkSlime.NextJumpTime = JumpInterval * Lane / FMath::Max(NumSlimes, 1);
+		BenchmarkSlime.ClimbStartTime = -1.0f;
+	}
+}
+
+void ASlimeBenchmark::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (IsFinished) return;
+
+	ElapsedTime += DeltaTime;
+
+	for (FBenchmarkSlime& BenchmarkSlime : Slimes)
+	{
+		DriveSlime(BenchmarkSlime);
+	}
+
+	RecordFrame(DeltaTime);
+
+	if (ElapsedTime >= WarmupSeconds + DurationSeconds)
+	{
+		IsFinished = true;
+		WriteResults();
+
+		if (ExitWhenFinished)
+		{
+			FPlatformMisc::RequestExit(false, TEXT("SlimeBenchmark"));
+		}
+	}
+}
+
+void ASlimeBenchmark::DriveSlime(FBenchmarkSlime& BenchmarkSlime)
+{
+	ASlimeCharacter* Slime = BenchmarkSlime.Slime;
+	if (!IsValid(Slime) || !Slime->GetController()) return;
+
+	if (Slime->IsInState<ClimbingState>())
+	{
+		if (BenchmarkSlime.ClimbStartTime < 0.0f)
+		{
+			BenchmarkSlime.ClimbStartTime = ElapsedTime;
+		}
+
+		Slime->OnWallMove(FInputActionValue(FVector2D(0.0f, 1.0f)));
+
+		//Let go of the wall so the slime falls back to the floor
+		if (ElapsedTime - BenchmarkSlime.ClimbStartTime > ClimbDuration)
+		{
+			Slime->Detach(FInputActionValue());
+			BenchmarkSlime.ClimbStartTime = -1.0f;
+		}
+		return;
+	}
+
+	BenchmarkSlime.ClimbStartTime = -1.0f;
+
+	//Walk towards the wall at the end of the lane
+	Slime->Move(FInputActionValue(FVector2D(0.0f, 1.0f)));
+
+	if (Slime->IsInState<DefaultState>() && ElapsedTime >= BenchmarkSlime.NextJumpTime)
+	{
+		Slime->SetJumpVelocity(FVector(1000.0f));
+		Slime->Jump(FInputActionValue());
+		BenchmarkSlime.NextJumpTime = ElapsedTime + JumpInterval;
+	}
+}
+
+void ASlimeBenchmark::RecordFrame(const float DeltaTime)
+{
+	FBenchmarkFrame Frame = {};
+	Frame.DeltaSeconds = DeltaTime;
+
+	for (FBenchmarkSlime& BenchmarkSlime : Slimes)
+	{
+		if (!IsValid(BenchmarkSlime.Slime)) continue;
+
+		const FSlimeMovementMetrics& Metrics = BenchmarkSlime.Slime->GetMovementMetrics();
+		const FSlimeMovementMetrics& LastMetrics = BenchmarkSlime.LastMetrics;
+
+		Frame.Traces += Metrics.TracesIssued - LastMetrics.TracesIssued;
+		Frame.Transitions += Metrics.Transitions - LastMetrics.Transitions;
+
+		for (int32 StateIndex = 0; StateIndex < NumPlayerStates; ++StateIndex)
+		{
+			Frame.StateUpdateCycles[StateIndex] += Metrics.StateUpdateCycles[StateIndex] - LastMetrics.StateUpdateCycles[StateIndex];
+			Frame.StateUpdateCount[StateIndex] += Metrics.StateUpdateCount[StateIndex] - LastMetrics.StateUpdateCount[StateIndex];
+		}
+
+		BenchmarkSlime.LastMetrics = Metrics;
+	}
+
+	if (ElapsedTime > WarmupSeconds)
+	{
+		Frames.Add(Frame);
+	}
+}
+
+void ASlimeBenchmark::WriteResults() const
+{
+	if (Frames.IsEmpty()) return;
+
+	const FString OutputDirectory = FPaths::ProfilingDir() / TEXT("SlimeBenchmark");
+
+	//Per frame results
+	FString FramesCsv = TEXT("Frame,DeltaMs,Traces,Transitions");
+	for (int32 StateIndex = 1; StateIndex < NumPlayerStates; ++StateIndex)
+	{
+		FramesCsv += FString::Printf(TEXT(",%sUs"), *ASlimeCharacter::GetStateName(StateIndex).ToString());
+	}
+	FramesCsv += LINE_TERMINATOR;
+
+	TArray<float> FrameTimes;
+	uint64 TotalTraces = 0;
+	uint64 TotalTransitions = 0;
+	uint64 TotalStateCycles[NumPlayerStates] = {};
+	uint64 TotalStateUpdates[NumPlayerStates] = {};
+	double TotalSeconds = 0.0;
+
+	for (int32 FrameIndex = 0; FrameIndex < Frames.Num(); ++FrameIndex)
+	{
+		const FBenchmarkFrame& Frame = Frames[FrameIndex];
+
+		FramesCsv += FString::Printf(TEXT("%d,%.3f,%u,%u"), FrameIndex, Frame.DeltaSeconds * 1000.0f, Frame.Traces, Frame.Transitions);
+		for (int32 StateIndex = 1; StateIndex < NumPlayerStates; ++StateIndex)
+		{
+			FramesCsv += FString::Printf(TEXT(",%.2f"), FPlatformTime::ToMilliseconds64(Frame.StateUpdateCycles[StateIndex]) * 1000.0);
+			TotalStateCycles[StateIndex] += Frame.StateUpdateCycles[StateIndex];
+			TotalStateUpdates[StateIndex] += Frame.StateUpdateCount[StateIndex];
+		}
+		FramesCsv += LINE_TERMINATOR;
+
+		FrameTimes.Add(Frame.DeltaSeconds * 1000.0f);
+		TotalTraces += Frame.Traces;
+		TotalTransitions += Frame.Transitions;
+		TotalSeconds += Frame.DeltaSeconds;
+	}
+
+	FFileHelper::SaveStringToFile(FramesCsv, *(OutputDirectory / OutputName + TEXT("_frames.csv")));
+
+	//Summary
+	FrameTimes.Sort();
+	const int32 NumFrames = Frames.Num();
+
+	FString SummaryCsv = TEXT("Metric,Value") LINE_TERMINATOR;
+	SummaryCsv += FString::Printf(TEXT("Slimes,%d") LINE_TERMINATOR, Slimes.Num());
+	SummaryCsv += FString::Printf(TEXT("Frames,%d") LINE_TERMINATOR, NumFrames);
+	SummaryCsv += FString::Printf(TEXT("FrameMsP50,%.3f") LINE_TERMINATOR, FrameTimes[NumFrames / 2]);
+	SummaryCsv += FString::Printf(TEXT("FrameMsP95,%.3f") LINE_TERMINATOR, FrameTimes[FMath::Min(NumFrames * 95 / 100, NumFrames - 1)]);
+	SummaryCsv += FString::Printf(TEXT("TracesPerFrame,%.2f") LINE_TERMINATOR, static_cast<double>(TotalTraces) / NumFrames);
+	SummaryCsv += FString::Printf(TEXT("TransitionsPerSecond,%.2f") LINE_TERMINATOR, TotalSeconds > 0.0 ? TotalTransitions / TotalSeconds : 0.0);
+	SummaryCsv += LINE_TERMINATOR;
+
+	SummaryCsv += TEXT("State,TotalMs,Updates,UsPerUpdate,UsPerFrame") LINE_TERMINATOR;
+	for (int32 StateIndex = 1; StateIndex < NumPlayerStates; ++StateIndex)
+	{
+		const double TotalMs = FPlatformTime::ToMilliseconds64(TotalStateCycles[StateIndex]);
+		const uint64 Updates = TotalStateUpdates[StateIndex];
+
+		SummaryCsv += FString::Printf(TEXT("%s,%.3f,%llu,%.3f,%.3f") LINE_TERMINATOR,
+			*ASlimeCharacter::GetStateName(StateIndex).ToString(),
+			TotalMs,
+			Updates,
+			Updates > 0 ? TotalMs * 1000.0 / Updates : 0.0,
+			TotalMs * 1000.0 / NumFrames);
+	}
+
+	FFileHelper::SaveStringToFile(SummaryCsv, *(OutputDirectory / OutputName + TEXT("_summary.csv")));
+
+	UE_LOG(LogTemp, Display, TEXT("Slime benchmark written to %s"), *OutputDirectory);
+}
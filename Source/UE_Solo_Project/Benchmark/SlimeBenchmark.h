@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+
+#include "../SlimeCharacter.h"
+
+#include "SlimeBenchmark.generated.h"
+
+// A scripted slime and the times its next inputs are due
+struct FBenchmarkSlime
+{
+	ASlimeCharacter* Slime;
+	float NextJumpTime;
+	float ClimbStartTime;
+	FSlimeMovementMetrics LastMetrics;
+};
+
+// Movement cost of every benchmark slime for a single frame
+struct FBenchmarkFrame
+{
+	float DeltaSeconds;
+	uint32 Traces;
+	uint32 Transitions;
+	uint64 StateUpdateCycles[NumPlayerStates];
+	uint32 StateUpdateCount[NumPlayerStates];
+};
+
+// Builds a test course of floors, walls and ledges, drives slimes through
+// Default -> Jumping -> Climbing -> Falling and writes the results as CSV
+UCLASS()
+class UE_SOLO_PROJECT_API ASlimeBenchmark : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category = "Benchmark")
+	TSubclassOf<ASlimeCharacter> SlimeClass;
+
+	UPROPERTY(EditAnywhere, Category = "Benchmark")
+	int32 NumSlimes = 16;
+
+	UPROPERTY(EditAnywhere, Category = "Benchmark")
+	float WarmupSeconds = 2.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Benchmark")
+	float DurationSeconds = 30.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Benchmark")
+	float JumpInterval = 3.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Benchmark")
+	float ClimbDuration = 2.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Benchmark")
+	float LaneSpacing = 500.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Benchmark")
+	FString OutputName = TEXT("SlimeBenchmark");
+
+	UPROPERTY(EditAnywhere, Category = "Benchmark")
+	bool ExitWhenFinished = false;
+
+private:
+	TArray<FBenchmarkSlime> Slimes;
+	TArray<FBenchmarkFrame> Frames;
+
+	float ElapsedTime = 0.0f;
+	bool IsFinished = false;
+
+public:
+	ASlimeBenchmark();
+
+	virtual void Tick(float DeltaTime) override;
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	void BuildTestLevel();
+
+	void SpawnBlock(UStaticMesh* Mesh, const FVector& Location, const FVector& Size);
+
+	void SpawnSlimes();
+
+	void DriveSlime(FBenchmarkSlime& BenchmarkSlime);
+
+	void RecordFrame(const float DeltaTime);
+
+	void WriteResults() const;
+};
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeBenchmarkSubsystem.h"
+
+#include "SlimeBenchmark.h"
+
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+bool USlimeBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && FParse::Param(FCommandLine::Get(), TEXT("SlimeBenchmark"));
+}
+
+bool USlimeBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USlimeBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	//Keep the generated course well away from the level's own geometry
+	const FTransform SpawnTransform(FVector(0.0f, 0.0f, 20000.0f));
+
+	ASlimeBenchmark* Benchmark = InWorld.SpawnActorDeferred<ASlimeBenchmark>(ASlimeBenchmark::StaticClass(), SpawnTransform);
+	if (!Benchmark) return;
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	FParse::Value(CommandLine, TEXT("SlimeBenchmarkCount="), Benchmark->NumSlimes);
+	FParse::Value(CommandLine, TEXT("SlimeBenchmarkDuration="), Benchmark->DurationSeconds);
+	FParse::Value(CommandLine, TEXT("SlimeBenchmarkOutput="), Benchmark->OutputName);
+	Benchmark->ExitWhenFinished = FParse::Param(CommandLine, TEXT("SlimeBenchmarkExit"));
+
+	FString SlimeClassPath;
+	if (FParse::Value(CommandLine, TEXT("SlimeBenchmarkClass="), SlimeClassPath))
+	{
+		Benchmark->SlimeClass = LoadClass<ASlimeCharacter>(nullptr, *SlimeClassPath);
+	}
+
+	Benchmark->FinishSpawning(SpawnTransform);
+}
@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "SlimeBenchmarkSubsystem.generated.h"
+
+// Spawns an ASlimeBenchmark when the game is started with -SlimeBenchmark, e.g.
+// UnrealEditor-Cmd UE_Solo_Project -game -nullrhi -unattended -SlimeBenchmark -SlimeBenchmarkCount=64 -SlimeBenchmarkExit
+UCLASS()
+class UE_SOLO_PROJECT_API USlimeBenchmarkSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+};
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeInputRecording.h"
+
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+
+namespace SlimeInputRecording
+{
+	constexpr uint32 Magic = 0x52494C53; // "SLIR"
+	constexpr uint32 Version = 1;
+
+	int32 GetNumAxes(const EInputActionValueType ValueType)
+	{
+		switch (ValueType)
+		{
+		case EInputActionValueType::Axis3D: return 3;
+		case EInputActionValueType::Axis2D: return 2;
+		default: return 1;
+		}
+	}
+}
+
+uint8 FSlimeInputRecording::FindOrAddSlot(const FString& ActionPath, const ETriggerEvent TriggerEvent)
+{
+	const int32 Slot = Slots.IndexOfByPredicate([&ActionPath, TriggerEvent](const FSlimeRecordedSlot& RecordedSlot)
+	{
+		return RecordedSlot.TriggerEvent == TriggerEvent && RecordedSlot.ActionPath == ActionPath;
+	});
+	if (Slot != INDEX_NONE) return static_cast<uint8>(Slot);
+
+	check(Slots.Num() < MAX_uint8);
+	return static_cast<uint8>(Slots.Add({ ActionPath, TriggerEvent }));
+}
+
+bool FSlimeInputRecording::SaveToFile(const FString& Filename) const
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Writer) return false;
+
+	const_cast<FSlimeInputRecording*>(this)->Serialize(*Writer);
+	return Writer->Close();
+}
+
+bool FSlimeInputRecording::LoadFromFile(const FString& Filename)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!Reader) return false;
+
+	Serialize(*Reader);
+	return !Reader->IsError() && Reader->Close();
+}
+
+void FSlimeInputRecording::Serialize(FArchive& Ar)
+{
+	uint32 Magic = SlimeInputRecording::Magic;
+	uint32 Version = SlimeInputRecording::Version;
+	Ar << Magic << Version;
+
+	if (Magic != SlimeInputRecording::Magic || Version != SlimeInputRecording::Version)
+	{
+		Ar.SetError();
+		return;
+	}
+
+	Ar << MapName << FixedDeltaTime << NumFrames;
+	Ar << StartLocation << StartRotation << StartControlRotation;
+
+	int32 NumSlots = Slots.Num();
+	Ar << NumSlots;
+	if (Ar.IsLoading())
+	{
+		Slots.SetNum(FMath::Clamp(NumSlots, 0, static_cast<int32>(MAX_uint8)));
+	}
+	for (FSlimeRecordedSlot& RecordedSlot : Slots)
+	{
+		uint8 TriggerEvent = static_cast<uint8>(RecordedSlot.TriggerEvent);
+		Ar << RecordedSlot.ActionPath << TriggerEvent;
+		RecordedSlot.TriggerEvent = static_cast<ETriggerEvent>(TriggerEvent);
+	}
+
+	uint32 NumInputs = Inputs.Num();
+	Ar.SerializeIntPacked(NumInputs);
+	if (Ar.IsLoading())
+	{
+		Inputs.SetNum(NumInputs);
+	}
+
+	uint32 PreviousFrame = 0;
+	for (FSlimeRecordedInput& Input : Inputs)
+	{
+		uint32 FrameDelta = Input.Frame - PreviousFrame;
+		Ar.SerializeIntPacked(FrameDelta);
+		Input.Frame = PreviousFrame + FrameDelta;
+		PreviousFrame = Input.Frame;
+
+		uint8 ValueType = static_cast<uint8>(Input.Value.GetValueType());
+		Ar << Input.Slot << ValueType;
+
+		FVector3f Axes(Input.Value.Get<FVector>());
+		for (int32 Axis = 0; Axis < SlimeInputRecording::GetNumAxes(static_cast<EInputActionValueType>(ValueType)); ++Axis)
+		{
+			Ar << Axes[Axis];
+		}
+
+		if (Ar.IsLoading())
+		{
+			Input.Value = FInputActionValue(static_cast<EInputActionValueType>(ValueType), FVector(Axes));
+		}
+	}
+}
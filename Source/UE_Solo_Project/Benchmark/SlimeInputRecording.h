@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputActionValue.h"
+#include "InputTriggers.h"
+
+// An action and trigger event the recording refers to by slot
+struct FSlimeRecordedSlot
+{
+	FString ActionPath;
+	ETriggerEvent TriggerEvent = ETriggerEvent::None;
+};
+
+// A single dispatched input
+struct FSlimeRecordedInput
+{
+	uint32 Frame = 0;
+	uint8 Slot = 0;
+	FInputActionValue Value;
+};
+
+// Per frame stream of the input a slime received, written as a compact binary file.
+// Frames are delta encoded and each value only stores the axes its type uses
+struct UE_SOLO_PROJECT_API FSlimeInputRecording
+{
+	FString MapName;
+	float FixedDeltaTime = 1.0f / 60.0f;
+	uint32 NumFrames = 0;
+	FVector StartLocation = FVector::ZeroVector;
+	FRotator StartRotation = FRotator::ZeroRotator;
+	FRotator StartControlRotation = FRotator::ZeroRotator;
+
+	TArray<FSlimeRecordedSlot> Slots;
+	TArray<FSlimeRecordedInput> Inputs;
+
+	// Returns the slot for the action and trigger, adding it on first use
+	uint8 FindOrAddSlot(const FString& ActionPath, const ETriggerEvent TriggerEvent);
+
+	bool SaveToFile(const FString& Filename) const;
+
+	bool LoadFromFile(const FString& Filename);
+
+private:
+	void Serialize(FArchive& Ar);
+};
@@ -0,0 +1,282 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeInputReplaySubsystem.h"
+
+#include "../SlimeCharacter.h"
+
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+namespace SlimeInputReplay
+{
+	bool HasInputFile()
+	{
+		FString Filename;
+		return FParse::Value(FCommandLine::Get(), TEXT("SlimeRecordInput="), Filename)
+			|| FParse::Value(FCommandLine::Get(), TEXT("SlimeReplayInput="), Filename);
+	}
+
+	float GetPercentile(const TArray<float>& SortedValues, const int32 Percentile)
+	{
+		return SortedValues[FMath::Min(SortedValues.Num() * Percentile / 100, SortedValues.Num() - 1)];
+	}
+}
+
+bool USlimeInputReplaySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && SlimeInputReplay::HasInputFile();
+}
+
+bool USlimeInputReplaySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USlimeInputReplaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+
+	Replaying = FParse::Value(CommandLine, TEXT("SlimeReplayInput="), RecordingFile);
+	if (!Replaying)
+	{
+		FParse::Value(CommandLine, TEXT("SlimeRecordInput="), RecordingFile);
+	}
+	RecordingFile = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir(), RecordingFile);
+
+	OutputName = FPaths::GetBaseFilename(RecordingFile);
+	FParse::Value(CommandLine, TEXT("SlimeReplayOutput="), OutputName);
+	ExitWhenFinished = FParse::Param(CommandLine, TEXT("SlimeReplayExit"));
+
+	if (Replaying)
+	{
+		if (!Recording.LoadFromFile(RecordingFile))
+		{
+			UE_LOG(LogTemp, Error, TEXT("SlimeInputReplay: could not read %s"), *RecordingFile);
+			Replaying = false;
+			IsFinished = true;
+			return;
+		}
+
+		if (Recording.MapName != GetWorld()->GetMapName())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SlimeInputReplay: %s was recorded on %s"), *RecordingFile, *Recording.MapName);
+		}
+	}
+	else
+	{
+		Recording.MapName = GetWorld()->GetMapName();
+		FParse::Value(CommandLine, TEXT("SlimeInputFPS="), Recording.FixedDeltaTime);
+		Recording.FixedDeltaTime = Recording.FixedDeltaTime > 1.0f ? 1.0f / Recording.FixedDeltaTime : 1.0f / 60.0f;
+	}
+
+	//Frames only line up between runs if they advance by the same amount
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(Recording.FixedDeltaTime);
+	FMath::RandInit(0);
+	FMath::SRandInit(0);
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &USlimeInputReplaySubsystem::OnPreActorTick);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &USlimeInputReplaySubsystem::OnPostActorTick);
+}
+
+void USlimeInputReplaySubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	if (!Replaying && !RecordingFile.IsEmpty() && Recording.NumFrames > 0)
+	{
+		if (Recording.SaveToFile(RecordingFile))
+		{
+			UE_LOG(LogTemp, Display, TEXT("SlimeInputReplay: recorded %u frames, %d inputs to %s"), Recording.NumFrames, Recording.Inputs.Num(), *RecordingFile);
+		}
+	}
+
+	if (Replaying && !IsFinished)
+	{
+		WriteResults();
+	}
+
+	if (ASlimeCharacter* Character = Slime.Get())
+	{
+		Character->SetInputReplay(nullptr);
+	}
+
+	Super::Deinitialize();
+}
+
+bool USlimeInputReplaySubsystem::IsReplaying() const
+{
+	return Replaying;
+}
+
+void USlimeInputReplaySubsystem::RecordInput(const FInputBindingSlot& BindingSlot, const FInputActionValue& Value)
+{
+	if (Replaying || !BindingSlot.Action) return;
+
+	FSlimeRecordedInput& Input = Recording.Inputs.AddDefaulted_GetRef();
+	Input.Frame = Frame;
+	Input.Slot = Recording.FindOrAddSlot(BindingSlot.Action->GetPathName(), BindingSlot.TriggerEvent);
+	Input.Value = Value;
+}
+
+void USlimeInputReplaySubsystem::OnPreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld != GetWorld() || IsFinished) return;
+	if (!Slime.IsValid() && !AttachToSlime()) return;
+
+	const double Now = FPlatformTime::Seconds();
+	if (Replaying && FrameStartSeconds > 0.0)
+	{
+		FrameTimes.Add(static_cast<float>((Now - FrameStartSeconds) * 1000.0));
+	}
+	FrameStartSeconds = Now;
+	WorldTickStartSeconds = Now;
+
+	if (Replaying)
+	{
+		InjectInputs();
+	}
+}
+
+void USlimeInputReplaySubsystem::OnPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld != GetWorld() || IsFinished) return;
+
+	ASlimeCharacter* Character = Slime.Get();
+	if (!Character) return;
+
+	++Frame;
+
+	if (!Replaying)
+	{
+		Recording.NumFrames = Frame;
+		return;
+	}
+
+	const uint32 TracesIssued = Character->GetMovementMetrics().TracesIssued;
+	WorldTickTimes.Add(static_cast<float>((FPlatformTime::Seconds() - WorldTickStartSeconds) * 1000.0));
+	FrameTraces.Add(TracesIssued - LastTracesIssued);
+	LastTracesIssued = TracesIssued;
+
+	if (Frame >= Recording.NumFrames)
+	{
+		IsFinished = true;
+		WriteResults();
+
+		if (ExitWhenFinished)
+		{
+			FPlatformMisc::RequestExit(false, TEXT("SlimeInputReplay"));
+		}
+	}
+}
+
+bool USlimeInputReplaySubsystem::AttachToSlime()
+{
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	ASlimeCharacter* Character = PlayerController ? Cast<ASlimeCharacter>(PlayerController->GetPawn()) : nullptr;
+	if (!Character) return false;
+
+	Slime = Character;
+	Character->SetInputReplay(this);
+	LastTracesIssued = Character->GetMovementMetrics().TracesIssued;
+
+	if (Replaying)
+	{
+		Character->TeleportTo(Recording.StartLocation, Recording.StartRotation, false, true);
+		PlayerController->SetControlRotation(Recording.StartControlRotation);
+		BuildSlotMap();
+	}
+	else
+	{
+		Recording.StartLocation = Character->GetActorLocation();
+		Recording.StartRotation = Character->GetActorRotation();
+		Recording.StartControlRotation = PlayerController->GetControlRotation();
+	}
+	return true;
+}
+
+void USlimeInputReplaySubsystem::BuildSlotMap()
+{
+	const TArray<FInputBindingSlot>& BindingSlots = Slime->GetBindingSlots();
+
+	SlotMap.Reset();
+	for (const FSlimeRecordedSlot& RecordedSlot : Recording.Slots)
+	{
+		const int32 Slot = BindingSlots.IndexOfByPredicate([&RecordedSlot](const FInputBindingSlot& BindingSlot)
+		{
+			return BindingSlot.Action && BindingSlot.TriggerEvent == RecordedSlot.TriggerEvent && BindingSlot.Action->GetPathName() == RecordedSlot.ActionPath;
+		});
+
+		if (Slot == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SlimeInputReplay: %s is no longer bound, its inputs are skipped"), *RecordedSlot.ActionPath);
+		}
+		SlotMap.Add(Slot);
+	}
+}
+
+void USlimeInputReplaySubsystem::InjectInputs()
+{
+	ASlimeCharacter* Character = Slime.Get();
+
+	while (Recording.Inputs.IsValidIndex(NextInput) && Recording.Inputs[NextInput].Frame <= Frame)
+	{
+		const FSlimeRecordedInput& Input = Recording.Inputs[NextInput++];
+
+		if (SlotMap.IsValidIndex(Input.Slot) && SlotMap[Input.Slot] != INDEX_NONE)
+		{
+			Character->InvokeBinding(Input.Value, SlotMap[Input.Slot]);
+		}
+	}
+}
+
+void USlimeInputReplaySubsystem::WriteResults() const
+{
+	if (FrameTimes.IsEmpty() || WorldTickTimes.IsEmpty()) return;
+
+	TArray<float> SortedFrameTimes = FrameTimes;
+	TArray<float> SortedWorldTickTimes = WorldTickTimes;
+	SortedFrameTimes.Sort();
+	SortedWorldTickTimes.Sort();
+
+	uint64 TotalTraces = 0;
+	uint32 MaxTraces = 0;
+	for (const uint32 Traces : FrameTraces)
+	{
+		TotalTraces += Traces;
+		MaxTraces = FMath::Max(MaxTraces, Traces);
+	}
+
+	FString SummaryCsv = TEXT("Metric,Value") LINE_TERMINATOR;
+	SummaryCsv += FString::Printf(TEXT("Frames,%d") LINE_TERMINATOR, WorldTickTimes.Num());
+	SummaryCsv += FString::Printf(TEXT("Inputs,%d") LINE_TERMINATOR, NextInput);
+	for (const int32 Percentile : { 50, 90, 95, 99 })
+	{
+		SummaryCsv += FString::Printf(TEXT("FrameMsP%d,%.3f") LINE_TERMINATOR, Percentile, SlimeInputReplay::GetPercentile(SortedFrameTimes, Percentile));
+		SummaryCsv += FString::Printf(TEXT("WorldTickMsP%d,%.3f") LINE_TERMINATOR, Percentile, SlimeInputReplay::GetPercentile(SortedWorldTickTimes, Percentile));
+	}
+	SummaryCsv += FString::Printf(TEXT("FrameMsMax,%.3f") LINE_TERMINATOR, SortedFrameTimes.Last());
+	SummaryCsv += FString::Printf(TEXT("Traces,%llu") LINE_TERMINATOR, TotalTraces);
+	SummaryCsv += FString::Printf(TEXT("TracesPerFrame,%.2f") LINE_TERMINATOR, static_cast<double>(TotalTraces) / FrameTraces.Num());
+	SummaryCsv += FString::Printf(TEXT("TracesMax,%u") LINE_TERMINATOR, MaxTraces);
+
+	FString FramesCsv = TEXT("Frame,WorldTickMs,Traces") LINE_TERMINATOR;
+	for (int32 FrameIndex = 0; FrameIndex < WorldTickTimes.Num(); ++FrameIndex)
+	{
+		FramesCsv += FString::Printf(TEXT("%d,%.3f,%u") LINE_TERMINATOR, FrameIndex, WorldTickTimes[FrameIndex], FrameTraces[FrameIndex]);
+	}
+
+	const FString OutputDirectory = FPaths::ProfilingDir() / TEXT("SlimeReplay");
+	FFileHelper::SaveStringToFile(SummaryCsv, *(OutputDirectory / OutputName + TEXT("_summary.csv")));
+	FFileHelper::SaveStringToFile(FramesCsv, *(OutputDirectory / OutputName + TEXT("_frames.csv")));
+
+	UE_LOG(LogTemp, Display, TEXT("SlimeInputReplay: results written to %s"), *OutputDirectory);
+}
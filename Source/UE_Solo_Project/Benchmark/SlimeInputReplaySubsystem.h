@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "SlimeInputRecording.h"
+
+#include "SlimeInputReplaySubsystem.generated.h"
+
+class ASlimeCharacter;
+struct FInputBindingSlot;
+
+// Records the local slime's input with -SlimeRecordInput=<File> or drives it from a recording with
+// -SlimeReplayInput=<File>. Both run under a fixed timestep so a replay sees the same frames, e.g.
+// UnrealEditor-Cmd UE_Solo_Project <Map> -game -nullrhi -unattended -SlimeReplayInput=Route.slimeinput -SlimeReplayExit
+// Replays write frame time percentiles and trace counts under Saved/Profiling/SlimeReplay
+UCLASS()
+class UE_SOLO_PROJECT_API USlimeInputReplaySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	bool IsReplaying() const;
+
+	// Called by the slime for every live input it dispatches
+	void RecordInput(const FInputBindingSlot& BindingSlot, const FInputActionValue& Value);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FSlimeInputRecording Recording;
+	FString RecordingFile;
+	FString OutputName;
+	bool Replaying = false;
+	bool ExitWhenFinished = false;
+	bool IsFinished = false;
+
+	TWeakObjectPtr<ASlimeCharacter> Slime;
+
+	//Current frame relative to when the slime was found
+	uint32 Frame = 0;
+	int32 NextInput = 0;
+
+	//Recorded slot to the slime's binding slot
+	TArray<int32> SlotMap;
+
+	double FrameStartSeconds = 0.0;
+	double WorldTickStartSeconds = 0.0;
+	uint32 LastTracesIssued = 0;
+
+	TArray<float> FrameTimes;
+	TArray<float> WorldTickTimes;
+	TArray<uint32> FrameTraces;
+
+	FDelegateHandle PreActorTickHandle;
+	FDelegateHandle PostActorTickHandle;
+
+	void OnPreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	void OnPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	bool AttachToSlime();
+
+	void BuildSlotMap();
+
+	void InjectInputs();
+
+	void WriteResults() const;
+};
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+
+#include "SlimeCrowdFragments.generated.h"
+
+// Crowd equivalents of the ASlimeCharacter player states
+UENUM()
+enum class ESlimeCrowdState : uint8
+{
+	Default,
+	Jumping,
+	Falling,
+	Climbing
+};
+
+USTRUCT()
+struct UE_SOLO_PROJECT_API FSlimeGravityFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector GravityDirection = FVector(0.0f, 0.0f, -1.0f);
+};
+
+USTRUCT()
+struct UE_SOLO_PROJECT_API FSlimeMovementAxesFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector AxisX = FVector::RightVector;
+
+	UPROPERTY()
+	FVector AxisY = FVector::ForwardVector;
+};
+
+USTRUCT()
+struct UE_SOLO_PROJECT_API FSlimeChargeFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector ChargeVelocity = FVector::ZeroVector;
+
+	// Ballistic velocity while jumping or falling
+	UPROPERTY()
+	FVector Velocity = FVector::ZeroVector;
+};
+
+USTRUCT()
+struct UE_SOLO_PROJECT_API FSlimeStateFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	ESlimeCrowdState State = ESlimeCrowdState::Falling;
+
+	UPROPERTY()
+	float StateTime = 0.0f;
+};
+
+// Tuning shared by every slime spawned from the same config
+USTRUCT()
+struct UE_SOLO_PROJECT_API FSlimeCrowdParameters : public FMassConstSharedFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Slime")
+	float MaxDistanceFromSurface = 100.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Slime")
+	float MoveSpeed = 300.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Slime")
+	float GravityAcceleration = 980.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Slime")
+	float JumpInterval = 4.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Slime")
+	float MinChargeVelocity = 1000.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Slime")
+	float MaxChargeVelocity = 1300.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Slime")
+	float ChargeRate = 500.0f;
+};
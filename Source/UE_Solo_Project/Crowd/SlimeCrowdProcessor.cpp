@@ -0,0 +1,220 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeCrowdProcessor.h"
+
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+
+#include "Engine/World.h"
+
+#include "../SlimeSurfaceMath.h"
+
+namespace SlimeCrowd
+{
+	// One crowd slime's fragments for the duration of an update
+	struct FSlimeView
+	{
+		FTransform& Transform;
+		FSlimeGravityFragment& Gravity;
+		FSlimeMovementAxesFragment& Axes;
+		FSlimeChargeFragment& Charge;
+		FSlimeStateFragment& State;
+	};
+
+	bool TraceSurface(const UWorld& World, const FVector& Start, const FVector& End, FHitResult& OutHit)
+	{
+		return World.LineTraceSingleByChannel(OutHit, Start, End, ECC_GameTraceChannel1, FCollisionQueryParams(SCENE_QUERY_STAT(SlimeCrowdProbe), false));
+	}
+
+	void SetState(FSlimeView& Slime, const ESlimeCrowdState NewState)
+	{
+		Slime.State.State = NewState;
+		Slime.State.StateTime = 0.0f;
+	}
+
+	// Matches ASlimeCharacter::AttachToWall, the slime is reoriented onto the new surface
+	void AttachToSurface(FSlimeView& Slime, const FVector& SurfaceNormal)
+	{
+		Slime.Gravity.GravityDirection = SurfaceNormal * -1.0f;
+		FSlimeSurfaceMath::GetMovementAxes(SurfaceNormal, Slime.Axes.AxisX, Slime.Axes.AxisY);
+
+		//Floors have no wall axes, keep heading the same way along the floor. Coming off a wall the forward
+		//points straight out of the floor, so fall back to the old wall normal, then the world axes
+		const FQuat Rotation = Slime.Transform.GetRotation();
+		const FVector Candidates[] = { Rotation.GetForwardVector(), Rotation.GetUpVector(), FVector::ForwardVector, FVector::RightVector };
+
+		FVector Forward = Slime.Axes.AxisY.GetSafeNormal();
+		for (int32 Index = 0; Forward.IsNearlyZero() && Index < UE_ARRAY_COUNT(Candidates); ++Index)
+		{
+			Forward = FVector::VectorPlaneProject(Candidates[Index], SurfaceNormal).GetSafeNormal();
+		}
+
+		Slime.Transform.SetRotation(FRotationMatrix::MakeFromXZ(Forward, SurfaceNormal).ToQuat());
+	}
+
+	bool IsGrounded(const FSlimeView& Slime)
+	{
+		return Slime.Gravity.GravityDirection.Equals(FVector(0.0f, 0.0f, -1.0f));
+	}
+
+	// Matches ASlimeCharacter::HasPlayerFoundNewSurface
+	bool FindNewSurface(const UWorld& World, const FSlimeView& Slime, const FSlimeCrowdParameters& Parameters, FHitResult& OutHit)
+	{
+		const FVector Location = Slime.Transform.GetLocation();
+		const FQuat Rotation = Slime.Transform.GetRotation();
+		const float Distance = Parameters.MaxDistanceFromSurface;
+
+		return TraceSurface(World, Location, Location + Rotation.GetForwardVector() * (Distance / 2.0f), OutHit)
+			|| TraceSurface(World, Location, Location + Rotation.GetUpVector() * Distance, OutHit)
+			|| TraceSurface(World, Location, Location + Rotation.GetRightVector() * (Distance / 2.0f), OutHit)
+			|| TraceSurface(World, Location, Location + Rotation.GetRightVector() * -(Distance / 2.0f), OutHit);
+	}
+
+	// Matches ASlimeCharacter::HasPlayerFoundWrapAroundSurface
+	bool FindWrapAroundSurface(const UWorld& World, const FSlimeView& Slime, FHitResult& OutHit)
+	{
+		const FQuat Rotation = Slime.Transform.GetRotation();
+		const FVector Start = Slime.Transform.GetLocation() + Rotation.GetUpVector() * -200.0f;
+
+		return TraceSurface(World, Start, Start + Rotation.GetForwardVector() * -30.0f, OutHit);
+	}
+
+	void UpdateOnSurface(const UWorld& World, FSlimeView& Slime, const FSlimeCrowdParameters& Parameters, const float DeltaTime)
+	{
+		const FVector Location = Slime.Transform.GetLocation();
+		const bool IsClimbing = Slime.State.State == ESlimeCrowdState::Climbing;
+
+		FHitResult HitResult;
+		if (!TraceSurface(World, Location, Location + Slime.Gravity.GravityDirection * Parameters.MaxDistanceFromSurface, HitResult))
+		{
+			if (FindWrapAroundSurface(World, Slime, HitResult))
+			{
+				Slime.Transform.SetLocation(FSlimeSurfaceMath::GetWrapAroundLocation(HitResult));
+				AttachToSurface(Slime, HitResult.Normal);
+				SetState(Slime, ESlimeCrowdState::Climbing);
+			}
+			else
+			{
+				Slime.Charge.Velocity = FVector::ZeroVector;
+				SetState(Slime, ESlimeCrowdState::Falling);
+			}
+			return;
+		}
+
+		if (FindNewSurface(World, Slime, Parameters, HitResult))
+		{
+			AttachToSurface(Slime, HitResult.Normal);
+			SetState(Slime, ESlimeCrowdState::Climbing);
+			return;
+		}
+
+		if (IsClimbing && IsGrounded(Slime))
+		{
+			SetState(Slime, ESlimeCrowdState::Default);
+		}
+
+		Slime.Transform.AddToTranslation(Slime.Transform.GetRotation().GetForwardVector() * Parameters.MoveSpeed * DeltaTime);
+
+		//Charge up and jump once the slime has been on the surface for a while
+		if (Slime.State.StateTime < Parameters.JumpInterval) return;
+
+		const float MaxVel = Parameters.MaxChargeVelocity;
+		Slime.Charge.ChargeVelocity = (Slime.Charge.ChargeVelocity + Parameters.ChargeRate * DeltaTime).BoundToBox(FVector(Parameters.MinChargeVelocity), FVector(MaxVel));
+
+		if (Slime.Charge.ChargeVelocity.X >= MaxVel)
+		{
+			const FQuat Rotation = Slime.Transform.GetRotation();
+			Slime.Charge.Velocity = Slime.Charge.ChargeVelocity * (Rotation.GetUpVector() + Rotation.GetForwardVector());
+			Slime.Charge.ChargeVelocity = FVector::ZeroVector;
+			SetState(Slime, ESlimeCrowdState::Jumping);
+		}
+	}
+
+	void UpdateInAir(const UWorld& World, FSlimeView& Slime, const FSlimeCrowdParameters& Parameters, const float DeltaTime)
+	{
+		//Falling always pulls back towards the world floor
+		if (Slime.State.State == ESlimeCrowdState::Falling)
+		{
+			Slime.Gravity.GravityDirection = FVector(0.0f, 0.0f, -1.0f);
+		}
+
+		Slime.Charge.Velocity += Slime.Gravity.GravityDirection * Parameters.GravityAcceleration * DeltaTime;
+
+		const FVector Start = Slime.Transform.GetLocation();
+		const FVector End = Start + Slime.Charge.Velocity * DeltaTime;
+
+		FHitResult HitResult;
+		if (!TraceSurface(World, Start, End, HitResult))
+		{
+			Slime.Transform.SetLocation(End);
+			return;
+		}
+
+		//Landed, stick to whatever was hit
+		Slime.Transform.SetLocation(HitResult.Location + HitResult.Normal * (Parameters.MaxDistanceFromSurface / 2.0f));
+		Slime.Charge.Velocity = FVector::ZeroVector;
+		AttachToSurface(Slime, HitResult.Normal);
+		SetState(Slime, IsGrounded(Slime) ? ESlimeCrowdState::Default : ESlimeCrowdState::Climbing);
+	}
+}
+
+USlimeCrowdProcessor::USlimeCrowdProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+	bRequiresGameThreadExecution = false;
+}
+
+void USlimeCrowdProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FSlimeGravityFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FSlimeMovementAxesFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FSlimeChargeFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FSlimeStateFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddConstSharedRequirement<FSlimeCrowdParameters>(EMassFragmentPresence::All);
+}
+
+void USlimeCrowdProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	const UWorld* World = EntityManager.GetWorld();
+	if (!World) return;
+
+	EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [World](FMassExecutionContext& Context)
+	{
+		const TArrayView<FTransformFragment> Transforms = Context.GetMutableFragmentView<FTransformFragment>();
+		const TArrayView<FSlimeGravityFragment> Gravities = Context.GetMutableFragmentView<FSlimeGravityFragment>();
+		const TArrayView<FSlimeMovementAxesFragment> AxesList = Context.GetMutableFragmentView<FSlimeMovementAxesFragment>();
+		const TArrayView<FSlimeChargeFragment> Charges = Context.GetMutableFragmentView<FSlimeChargeFragment>();
+		const TArrayView<FSlimeStateFragment> States = Context.GetMutableFragmentView<FSlimeStateFragment>();
+		const FSlimeCrowdParameters& Parameters = Context.GetConstSharedFragment<FSlimeCrowdParameters>();
+		const float DeltaTime = Context.GetDeltaTimeSeconds();
+
+		for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); ++EntityIndex)
+		{
+			SlimeCrowd::FSlimeView Slime = {
+				Transforms[EntityIndex].GetMutableTransform(),
+				Gravities[EntityIndex],
+				AxesList[EntityIndex],
+				Charges[EntityIndex],
+				States[EntityIndex]
+			};
+
+			Slime.State.StateTime += DeltaTime;
+
+			switch (Slime.State.State)
+			{
+			case ESlimeCrowdState::Default:
+			case ESlimeCrowdState::Climbing:
+				SlimeCrowd::UpdateOnSurface(*World, Slime, Parameters, DeltaTime);
+				break;
+			case ESlimeCrowdState::Jumping:
+			case ESlimeCrowdState::Falling:
+				SlimeCrowd::UpdateInAir(*World, Slime, Parameters, DeltaTime);
+				break;
+			}
+		}
+	});
+}
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+
+#include "SlimeCrowdFragments.h"
+
+#include "SlimeCrowdProcessor.generated.h"
+
+struct FTransformFragment;
+
+// Runs the Default/Jumping/Falling/Climbing rules of ASlimeCharacter for
+// every crowd slime, one chunk of entities per worker
+UCLASS()
+class UE_SOLO_PROJECT_API USlimeCrowdProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	USlimeCrowdProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
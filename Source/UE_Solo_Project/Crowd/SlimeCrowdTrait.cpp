@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeCrowdTrait.h"
+
+#include "MassCommonFragments.h"
+#include "MassEntityTemplateRegistry.h"
+#include "MassEntityUtils.h"
+
+void USlimeCrowdTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+	BuildContext.RequireFragment<FTransformFragment>();
+
+	BuildContext.AddFragment<FSlimeGravityFragment>();
+	BuildContext.AddFragment<FSlimeMovementAxesFragment>();
+	BuildContext.AddFragment<FSlimeChargeFragment>();
+	BuildContext.AddFragment<FSlimeStateFragment>();
+
+	FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
+	const FConstSharedStruct ParametersFragment = EntityManager.GetOrCreateConstSharedFragment(Parameters);
+	BuildContext.AddConstSharedFragment(ParametersFragment);
+}
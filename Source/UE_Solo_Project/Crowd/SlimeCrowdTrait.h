@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTraitBase.h"
+
+#include "SlimeCrowdFragments.h"
+
+#include "SlimeCrowdTrait.generated.h"
+
+// Adds the slime crowd fragments to a Mass entity config
+UCLASS(meta = (DisplayName = "Slime Crowd"))
+class UE_SOLO_PROJECT_API USlimeCrowdTrait : public UMassEntityTraitBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category = "Slime")
+	FSlimeCrowdParameters Parameters;
+
+protected:
+	virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+};
@@ -3,10 +3,17 @@
 
 #include "Item.h"
 
+#include "ItemPoolSubsystem.h"
+#include "ItemBobbingSubsystem.h"
+#include "ItemPhysicsLODSubsystem.h"
+
 // Sets default values
 AItem::AItem()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	//Held items are bobbed by UItemBobbingSubsystem
+	PrimaryActorTick.bCanEverTick = false;
+	bReplicates = true;
+	SetReplicatingMovement(true);
 	ItemMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("ItemMesh"));
 	ItemMesh->SetupAttachment(RootComponent);
 	ItemMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
@@ -14,8 +21,6 @@ AItem::AItem()
 
 	BoxCollision = CreateDefaultSubobject<UBoxComponent>(TEXT("BoxCollision"));
 	BoxCollision->SetupAttachment(ItemMesh);
-
-	RunningTime = 0.0f;
 }
 
 // Called when the game starts or when spawned
@@ -25,31 +30,15 @@ void AItem::BeginPlay()
 	
 }
 
-void AItem::Bobbing(float DeltaTime)
+void AItem::Bobbing(const float RunningTime)
 {
-	const float BobbingAmplitude = 0.5f; 
-	const float BobbingFrequency = 5.0f;  
-
-	// Calculate new Z position
-	FVector NewLocation = GetActorLocation();
-	NewLocation.Z += FMath::Sin(RunningTime * BobbingFrequency) * BobbingAmplitude;
-
-	// Update the actor's location
-	SetActorLocation(NewLocation);
+	const float BobbingAmplitude = 6.0f;
+	const float BobbingFrequency = 5.0f;
 
-	// Increment running time
-	RunningTime += DeltaTime;
-}
-
-// Called every frame
-void AItem::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
+	//Held items are snapped to the holder, so bob around that point rather than accumulating moves
+	const FVector Offset(0.0f, 0.0f, FMath::Sin(RunningTime * BobbingFrequency) * BobbingAmplitude);
 
-	if (IsHeld)
-	{
-		Bobbing(DeltaTime);
-	}
+	ItemMesh->SetRelativeLocation(Offset);
 }
 
 void AItem::Grab()
@@ -57,8 +46,19 @@ void AItem::Grab()
 	if (IsHeld)  return;
 
 	IsHeld = true;
+
+	if (UItemPhysicsLODSubsystem* PhysicsLODSubsystem = GetWorld()->GetSubsystem<UItemPhysicsLODSubsystem>())
+	{
+		PhysicsLODSubsystem->Unregister(this);
+	}
+
 	ItemMesh->SetSimulatePhysics(false);
 	ItemMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	if (UItemBobbingSubsystem* BobbingSubsystem = GetWorld()->GetSubsystem<UItemBobbingSubsystem>())
+	{
+		BobbingSubsystem->Register(this);
+	}
 }
 
 void AItem::Release()
@@ -66,9 +66,20 @@ void AItem::Release()
 	if (!IsHeld)  return;
 
 	IsHeld = false;
+
+	if (UItemBobbingSubsystem* BobbingSubsystem = GetWorld()->GetSubsystem<UItemBobbingSubsystem>())
+	{
+		BobbingSubsystem->Unregister(this);
+	}
+
 	ItemMesh->SetRelativeLocation(FVector(0.0f, 0.0f, 0.0f));
 	ItemMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 	ItemMesh->SetSimulatePhysics(true);
+
+	if (UItemPhysicsLODSubsystem* PhysicsLODSubsystem = GetWorld()->GetSubsystem<UItemPhysicsLODSubsystem>())
+	{
+		PhysicsLODSubsystem->Register(this);
+	}
 }
 
 void AItem::Launch(const FVector& Impulse)
@@ -76,3 +87,67 @@ void AItem::Launch(const FVector& Impulse)
 	ItemMesh->AddImpulse(Impulse, NAME_None, true);
 }
 
+bool AItem::GetIsHeld() const
+{
+	return IsHeld;
+}
+
+void AItem::Park()
+{
+	if (Parked) return;
+
+	Parked = true;
+
+	if (IsHeld)
+	{
+		Release();
+	}
+
+	if (UItemPhysicsLODSubsystem* PhysicsLODSubsystem = GetWorld()->GetSubsystem<UItemPhysicsLODSubsystem>())
+	{
+		PhysicsLODSubsystem->Unregister(this);
+	}
+
+	//Idle pooled items cost nothing until they are handed out again
+	ItemMesh->SetSimulatePhysics(false);
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+}
+
+void AItem::Unpark(const FTransform& Transform)
+{
+	if (!Parked) return;
+
+	Parked = false;
+
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	ItemMesh->SetRelativeLocation(FVector(0.0f, 0.0f, 0.0f));
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	ItemMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	ItemMesh->SetSimulatePhysics(true);
+
+	if (UItemPhysicsLODSubsystem* PhysicsLODSubsystem = GetWorld()->GetSubsystem<UItemPhysicsLODSubsystem>())
+	{
+		PhysicsLODSubsystem->Register(this);
+	}
+}
+
+bool AItem::IsParked() const
+{
+	return Parked;
+}
+
+void AItem::Recycle()
+{
+	if (UItemPoolSubsystem* ItemPool = GetWorld()->GetSubsystem<UItemPoolSubsystem>())
+	{
+		ItemPool->ReleaseItem(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
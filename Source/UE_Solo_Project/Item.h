@@ -20,21 +20,30 @@ public:
 	UBoxComponent* BoxCollision;
 private:
 	bool IsHeld = false;
-	float RunningTime;
+	bool Parked = false;
 public:	
 	// Sets default values for this actor's properties
 	AItem();
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
 
 	void Grab();
 	void Release();
 	void Launch(const FVector& Impulse);
 
+	bool GetIsHeld() const;
+
+	// Pooling
+	void Park();
+	void Unpark(const FTransform& Transform);
+	bool IsParked() const;
+
+	// Returns the item to the world's item pool
+	UFUNCTION(BlueprintCallable)
+	void Recycle();
+
+	// Offsets the item from where it is held, driven by UItemBobbingSubsystem
+	void Bobbing(const float RunningTime);
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
-
-private:
-	void Bobbing(float DeltaTime);
 };
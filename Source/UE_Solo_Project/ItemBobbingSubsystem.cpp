@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ItemBobbingSubsystem.h"
+
+#include "Item.h"
+#include "SlimeCharacter.h"
+
+void UItemBobbingSubsystem::Register(AItem* Item)
+{
+	if (!Item) return;
+
+	if (!BobbingItems.ContainsByPredicate([Item](const FBobbingItem& BobbingItem) { return BobbingItem.Item == Item; }))
+	{
+		BobbingItems.Add({ Item, 0.0f });
+	}
+}
+
+void UItemBobbingSubsystem::Unregister(AItem* Item)
+{
+	BobbingItems.RemoveAllSwap([Item](const FBobbingItem& BobbingItem) { return BobbingItem.Item == Item; });
+}
+
+void UItemBobbingSubsystem::Tick(float DeltaTime)
+{
+	for (int32 Index = BobbingItems.Num() - 1; Index >= 0; --Index)
+	{
+		FBobbingItem& BobbingItem = BobbingItems[Index];
+
+		AItem* Item = BobbingItem.Item.Get();
+		if (!Item)
+		{
+			BobbingItems.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		BobbingItem.RunningTime += DeltaTime;
+
+		//Bobbing only depends on the running time, so skipped frames don't need catching up
+		const ASlimeCharacter* Holder = Cast<ASlimeCharacter>(Item->GetAttachParentActor());
+		if (Holder && !Holder->ShouldUpdateCosmetics()) continue;
+
+		Item->Bobbing(BobbingItem.RunningTime);
+	}
+}
+
+TStatId UItemBobbingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UItemBobbingSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ItemBobbingSubsystem.generated.h"
+
+class AItem;
+
+// A held item and how long it has been bobbing
+struct FBobbingItem
+{
+	TWeakObjectPtr<AItem> Item;
+	float RunningTime;
+};
+
+// Updates every held item's bobbing in one loop so items themselves never tick
+UCLASS()
+class UE_SOLO_PROJECT_API UItemBobbingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	TArray<FBobbingItem> BobbingItems;
+
+public:
+	void Register(AItem* Item);
+
+	void Unregister(AItem* Item);
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+};
@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ItemPhysicsLODSubsystem.h"
+
+#include "Item.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+void UItemPhysicsLODSubsystem::Register(AItem* Item)
+{
+	if (!Item) return;
+
+	if (!Items.ContainsByPredicate([Item](const FPhysicsLODItem& LODItem) { return LODItem.Item == Item; }))
+	{
+		Items.Add({ Item, EItemPhysicsLOD::Full, FVector::ZeroVector });
+	}
+}
+
+void UItemPhysicsLODSubsystem::Unregister(AItem* Item)
+{
+	const int32 Index = Items.IndexOfByPredicate([Item](const FPhysicsLODItem& LODItem) { return LODItem.Item == Item; });
+	if (Index == INDEX_NONE) return;
+
+	//Hand the item back at full simulation so whoever unregistered it sees a normal body
+	SetLOD(Items[Index], EItemPhysicsLOD::Full);
+	Items.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UItemPhysicsLODSubsystem::Tick(float DeltaTime)
+{
+	//Visibility comes from rendering, which a dedicated server never does, so it keeps every item fully simulated for the clients it replicates to
+	if (GetWorld()->GetNetMode() == NM_DedicatedServer) return;
+
+	Items.RemoveAllSwap([](const FPhysicsLODItem& LODItem) { return !LODItem.Item.IsValid(); });
+
+	TimeUntilEvaluation -= DeltaTime;
+	if (TimeUntilEvaluation <= 0.0f)
+	{
+		TimeUntilEvaluation = EvaluationInterval;
+		EvaluateSignificance();
+	}
+
+	for (FPhysicsLODItem& LODItem : Items)
+	{
+		if (LODItem.LOD == EItemPhysicsLOD::Ballistic)
+		{
+			UpdateBallistic(LODItem, DeltaTime);
+		}
+	}
+}
+
+TStatId UItemPhysicsLODSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UItemPhysicsLODSubsystem, STATGROUP_Tickables);
+}
+
+void UItemPhysicsLODSubsystem::EvaluateSignificance()
+{
+	for (FPhysicsLODItem& LODItem : Items)
+	{
+		const AItem* Item = LODItem.Item.Get();
+
+		if (IsSignificant(Item))
+		{
+			SetLOD(LODItem, EItemPhysicsLOD::Full);
+		}
+		else if (LODItem.LOD == EItemPhysicsLOD::Full)
+		{
+			const FVector Velocity = Item->ItemMesh->GetPhysicsLinearVelocity();
+			SetLOD(LODItem, Velocity.Size() > SleepSpeed ? EItemPhysicsLOD::Ballistic : EItemPhysicsLOD::Dormant);
+		}
+	}
+}
+
+bool UItemPhysicsLODSubsystem::IsSignificant(const AItem* Item) const
+{
+	const FVector Location = Item->GetActorLocation();
+	const bool IsRendered = Item->WasRecentlyRendered(0.2f);
+
+	//Check against every splitscreen player's slime and view
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		if (!PlayerController) continue;
+
+		if (const APawn* Pawn = PlayerController->GetPawn())
+		{
+			if (FVector::DistSquared(Pawn->GetActorLocation(), Location) < FMath::Square(FullSimulationDistance))
+			{
+				return true;
+			}
+		}
+
+		if (!IsRendered || !PlayerController->PlayerCameraManager) continue;
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+		const FVector ToItem = Location - ViewLocation;
+		if (ToItem.SizeSquared() > FMath::Square(VisibleSimulationDistance)) continue;
+
+		const float CosHalfFOV = FMath::Cos(FMath::DegreesToRadians(PlayerController->PlayerCameraManager->GetFOVAngle() * 0.5f));
+		if (FVector::DotProduct(ViewRotation.Vector(), ToItem.GetSafeNormal()) > CosHalfFOV)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UItemPhysicsLODSubsystem::SetLOD(FPhysicsLODItem& LODItem, const EItemPhysicsLOD NewLOD)
+{
+	AItem* Item = LODItem.Item.Get();
+	if (!Item || LODItem.LOD == NewLOD) return;
+
+	UStaticMeshComponent* ItemMesh = Item->ItemMesh;
+
+	switch (NewLOD)
+	{
+	case EItemPhysicsLOD::Full:
+		if (LODItem.LOD == EItemPhysicsLOD::Ballistic)
+		{
+			ItemMesh->SetSimulatePhysics(true);
+			ItemMesh->SetPhysicsLinearVelocity(LODItem.Velocity);
+		}
+		ItemMesh->WakeRigidBody();
+		break;
+	case EItemPhysicsLOD::Ballistic:
+		LODItem.Velocity = ItemMesh->GetPhysicsLinearVelocity();
+		ItemMesh->SetSimulatePhysics(false);
+		break;
+	case EItemPhysicsLOD::Dormant:
+		if (LODItem.LOD == EItemPhysicsLOD::Ballistic)
+		{
+			ItemMesh->SetSimulatePhysics(true);
+		}
+		ItemMesh->PutRigidBodyToSleep();
+		break;
+	}
+
+	LODItem.LOD = NewLOD;
+}
+
+void UItemPhysicsLODSubsystem::UpdateBallistic(FPhysicsLODItem& LODItem, const float DeltaTime)
+{
+	AItem* Item = LODItem.Item.Get();
+	if (!Item) return;
+
+	LODItem.Velocity.Z += GetWorld()->GetGravityZ() * DeltaTime;
+
+	//Sweep the mesh's bounds so a landed item rests on the surface instead of sinking its pivot into it
+	const FBoxSphereBounds& Bounds = Item->ItemMesh->Bounds;
+	const FVector Start = Bounds.Origin;
+	const FVector End = Start + LODItem.Velocity * DeltaTime;
+
+	FCollisionQueryParams CollisionParams(SCENE_QUERY_STAT(ItemBallistic), false, Item);
+
+	FHitResult HitResult;
+	if (GetWorld()->SweepSingleByChannel(HitResult, Start, End, FQuat::Identity, ECC_Visibility, FCollisionShape::MakeBox(Bounds.BoxExtent), CollisionParams))
+	{
+		//Landed, rest on the surface until someone comes near
+		Item->AddActorWorldOffset(HitResult.Location - Start, false, nullptr, ETeleportType::TeleportPhysics);
+		LODItem.Velocity = FVector::ZeroVector;
+		SetLOD(LODItem, EItemPhysicsLOD::Dormant);
+		return;
+	}
+
+	Item->AddActorWorldOffset(End - Start, false, nullptr, ETeleportType::TeleportPhysics);
+}
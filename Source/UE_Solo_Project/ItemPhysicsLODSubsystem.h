@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ItemPhysicsLODSubsystem.generated.h"
+
+class AItem;
+
+UENUM()
+enum class EItemPhysicsLOD : uint8
+{
+	// Full rigid body simulation
+	Full,
+	// Physics off, flown along an analytic arc until it lands
+	Ballistic,
+	// Simulated but kept asleep
+	Dormant
+};
+
+// A loose item and the physics level it is currently running at
+struct FPhysicsLODItem
+{
+	TWeakObjectPtr<AItem> Item;
+	EItemPhysicsLOD LOD;
+	FVector Velocity;
+};
+
+// Demotes loose items that no player can see or reach to cheaper physics, and promotes them back near a slime.
+// Thresholds are read from the [/Script/UE_Solo_Project.ItemPhysicsLODSubsystem] section of DefaultGame.ini
+UCLASS(Config = Game)
+class UE_SOLO_PROJECT_API UItemPhysicsLODSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Items within this distance of any slime always fully simulate
+	UPROPERTY(Config)
+	float FullSimulationDistance = 2000.0f;
+
+	// Items seen by a player within this distance fully simulate
+	UPROPERTY(Config)
+	float VisibleSimulationDistance = 6000.0f;
+
+	// Items slower than this are put to sleep instead of flown ballistically
+	UPROPERTY(Config)
+	float SleepSpeed = 20.0f;
+
+	// Seconds between re-evaluating every item's physics level
+	UPROPERTY(Config)
+	float EvaluationInterval = 0.25f;
+
+private:
+	TArray<FPhysicsLODItem> Items;
+
+	float TimeUntilEvaluation = 0.0f;
+
+public:
+	void Register(AItem* Item);
+
+	void Unregister(AItem* Item);
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+private:
+	void EvaluateSignificance();
+
+	bool IsSignificant(const AItem* Item) const;
+
+	void SetLOD(FPhysicsLODItem& LODItem, const EItemPhysicsLOD NewLOD);
+
+	void UpdateBallistic(FPhysicsLODItem& LODItem, const float DeltaTime);
+};
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ItemPoolSubsystem.h"
+
+#include "Engine/World.h"
+
+void UItemPoolSubsystem::Prewarm(TSubclassOf<AItem> ItemClass, const int32 Count)
+{
+	if (!ItemClass) return;
+
+	FItemPoolEntries& Pool = Pools.FindOrAdd(ItemClass);
+	Pool.Items.Reserve(Count);
+
+	while (Pool.Items.Num() < Count)
+	{
+		AItem* Item = SpawnParkedItem(ItemClass);
+		if (!Item) break;
+
+		Pool.Items.Add(Item);
+	}
+}
+
+AItem* UItemPoolSubsystem::AcquireItem(TSubclassOf<AItem> ItemClass, const FTransform& Transform)
+{
+	if (!ItemClass) return nullptr;
+
+	AItem* Item = nullptr;
+
+	if (FItemPoolEntries* Pool = Pools.Find(ItemClass))
+	{
+		//Skip anything destroyed while parked
+		while (!Item && Pool->Items.Num() > 0)
+		{
+			AItem* Candidate = Pool->Items.Pop(EAllowShrinking::No);
+			if (IsValid(Candidate))
+			{
+				Item = Candidate;
+			}
+		}
+	}
+
+	if (!Item)
+	{
+		Item = SpawnParkedItem(ItemClass);
+		if (!Item) return nullptr;
+	}
+
+	Item->Unpark(Transform);
+	return Item;
+}
+
+void UItemPoolSubsystem::ReleaseItem(AItem* Item)
+{
+	if (!IsValid(Item) || Item->IsParked()) return;
+
+	Item->Park();
+	Pools.FindOrAdd(Item->GetClass()).Items.Add(Item);
+}
+
+int32 UItemPoolSubsystem::GetNumParked(TSubclassOf<AItem> ItemClass) const
+{
+	const FItemPoolEntries* Pool = Pools.Find(ItemClass);
+	return Pool ? Pool->Items.Num() : 0;
+}
+
+AItem* UItemPoolSubsystem::SpawnParkedItem(UClass* ItemClass)
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AItem* Item = GetWorld()->SpawnActor<AItem>(ItemClass, FTransform::Identity, SpawnParameters);
+	if (Item)
+	{
+		Item->Park();
+	}
+	return Item;
+}
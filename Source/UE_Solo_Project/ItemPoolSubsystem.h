@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "Item.h"
+
+#include "ItemPoolSubsystem.generated.h"
+
+// Parked items of a single class
+USTRUCT()
+struct FItemPoolEntries
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AItem>> Items;
+};
+
+// Keeps spawned items alive and hands them back out instead of spawning and destroying them
+UCLASS()
+class UE_SOLO_PROJECT_API UItemPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FItemPoolEntries> Pools;
+
+public:
+	// Spawns and parks items until the pool for the class holds at least Count
+	UFUNCTION(BlueprintCallable, Category = "Item Pool")
+	void Prewarm(TSubclassOf<AItem> ItemClass, const int32 Count);
+
+	// Takes a parked item out of the pool, spawning a new one if it is empty
+	UFUNCTION(BlueprintCallable, Category = "Item Pool")
+	AItem* AcquireItem(TSubclassOf<AItem> ItemClass, const FTransform& Transform);
+
+	// Parks the item until it is acquired again
+	UFUNCTION(BlueprintCallable, Category = "Item Pool")
+	void ReleaseItem(AItem* Item);
+
+	int32 GetNumParked(TSubclassOf<AItem> ItemClass) const;
+
+private:
+	AItem* SpawnParkedItem(UClass* ItemClass);
+};
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ItemSpawner.h"
+
+#include "ItemPoolSubsystem.h"
+
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+AItemSpawner::AItemSpawner()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	SpawnPoint = CreateDefaultSubobject<USceneComponent>(TEXT("SpawnPoint"));
+	RootComponent = SpawnPoint;
+}
+
+void AItemSpawner::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UItemPoolSubsystem* ItemPool = GetWorld()->GetSubsystem<UItemPoolSubsystem>())
+	{
+		ItemPool->Prewarm(ItemClass, MaxActiveItems);
+	}
+
+	if (SpawnInterval > 0.0f)
+	{
+		GetWorldTimerManager().SetTimer(SpawnTimerHandle, this, &AItemSpawner::SpawnItem, SpawnInterval, true, 0.0f);
+	}
+}
+
+void AItemSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(SpawnTimerHandle);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+AItem* AItemSpawner::SpawnItem()
+{
+	UItemPoolSubsystem* ItemPool = GetWorld()->GetSubsystem<UItemPoolSubsystem>();
+	if (!ItemPool) return nullptr;
+
+	ActiveItems.RemoveAll([](const AItem* Item) { return !IsValid(Item) || Item->IsParked(); });
+
+	//Recycle the oldest item that is not being carried
+	if (ActiveItems.Num() >= MaxActiveItems)
+	{
+		const int32 OldestIndex = ActiveItems.IndexOfByPredicate([](const AItem* Item) { return !Item->GetIsHeld(); });
+		if (OldestIndex == INDEX_NONE) return nullptr;
+
+		ItemPool->ReleaseItem(ActiveItems[OldestIndex]);
+		ActiveItems.RemoveAt(OldestIndex);
+	}
+
+	AItem* Item = ItemPool->AcquireItem(ItemClass, SpawnPoint->GetComponentTransform());
+	if (Item)
+	{
+		ActiveItems.Add(Item);
+	}
+	return Item;
+}
@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+
+#include "Item.h"
+
+#include "ItemSpawner.generated.h"
+
+// Spawns items from the world's item pool on a timer, recycling the oldest once MaxActiveItems is reached
+UCLASS()
+class UE_SOLO_PROJECT_API AItemSpawner : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	USceneComponent* SpawnPoint;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawning")
+	TSubclassOf<AItem> ItemClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawning")
+	float SpawnInterval = 5.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawning")
+	int32 MaxActiveItems = 5;
+
+private:
+	UPROPERTY()
+	TArray<TObjectPtr<AItem>> ActiveItems;
+
+	FTimerHandle SpawnTimerHandle;
+
+public:
+	AItemSpawner();
+
+	UFUNCTION(BlueprintCallable, Category = "Spawning")
+	AItem* SpawnItem();
+
+protected:
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+};
@@ -4,57 +4,100 @@
 #include "FallingState.h"
 #include "DefaultState.h"
 
+#include "../SlimeSurfaceMath.h"
 
-void ClimbingState::OnEnter()
-{
-	if (!Player->InputComponent) return;
-
-	Player->ResetBindings();
 
+void ClimbingState::SetUpBindings(ASlimeCharacter* Player)
+{
 	Player->SetUpBinding(Player->MoveAction, ETriggerEvent::Triggered, &ASlimeCharacter::OnWallMove);
 	Player->SetUpBinding(Player->JumpAction, ETriggerEvent::Triggered, &ASlimeCharacter::Jump);
 	Player->SetUpBinding(Player->DetachAction, ETriggerEvent::Triggered, &ASlimeCharacter::Detach);
 	Player->SetUpBinding(Player->ChargeJumpAction, ETriggerEvent::Ongoing, &ASlimeCharacter::ChargeJump);
 	Player->SetUpBinding(Player->ChargeJumpAction, ETriggerEvent::Triggered, &ASlimeCharacter::ChargeJump);
+}
+
+void ClimbingState::OnEnter()
+{
+	Player->SetMaterialOverTime(Player->DefaultMaterial.Get());
+
+	Player->GetSlimeMovement()->StartClimbing();
+}
 
-	Player->SetMaterialOverTime(Player->DefaultMaterial);
+void ClimbingState::OnExit()
+{
+	Player->GetSlimeMovement()->StopClimbing();
 }
 
-void ClimbingState::OnUpdate()
+FStateDecision ClimbingState::Decide() const
 {
-	if (Player->IsTransitioning) return;
+	const USlimeMovementComponent* Movement = Player->GetSlimeMovement();
+	FStateDecision Decision;
 
-	if (!Player->IsPlayerOnClimbableSurface())
+	//Boosting onto a wall leaves the climbing mode until the slime lands on it
+	if (!Movement->IsClimbing())
 	{
-		FVector NewGravity;
-		FVector NewLocation;
+		Decision.Action = Movement->IsMovingOnGround() ? Reattach : None;
+		return Decision;
+	}
 
-		UE_LOG(LogTemp, Error, TEXT("NO CLIMB SURFACE"));
+	if (Player->IsTransitioning) return Decision;
 
-		if (Player->HasPlayerFoundWrapAroundSurface(NewGravity, NewLocation))
+	//The climbing movement already traced for the surfaces this frame
+	const FSlimeClimbResult& ClimbResult = Movement->GetClimbResult();
+
+	if (!ClimbResult.HasSurface)
+	{
+		if (ClimbResult.HasWrapAround)
 		{
-			Player->ApplyLocationTransition(NewLocation);
-			Player->AttachToWall(NewGravity, false);
+			Decision.Action = WrapAround;
+			Decision.NewGravity = ClimbResult.WrapAroundHit.Normal * -1.0f;
+			Decision.NewLocation = FSlimeSurfaceMath::GetWrapAroundLocation(ClimbResult.WrapAroundHit);
 		}
 		else
 		{
-			Player->DetachFromWall();
-			Player->SetState<FallingState>();
-
-			UE_LOG(LogTemp, Error, TEXT("DETACH"));
+			Decision.Action = Fall;
 		}
 	}
-	else
+	else if (ClimbResult.IsOnFloor)
 	{
-		FVector NewGravity;
-		if (Player->HasPlayerFoundNewSurface(NewGravity))
-		{
-			Player->AttachToWall(NewGravity, true);
-		}
+		Decision.Action = Land;
+	}
+	else if (ClimbResult.HasNewSurface)
+	{
+		Decision.Action = Attach;
+		Decision.NewGravity = ClimbResult.NewSurfaceHit.Normal * -1.0f;
 	}
+	return Decision;
+}
 
-	if (Player->IsPlayerGrounded())
+void ClimbingState::Commit(const FStateDecision& Decision)
+{
+	switch (Decision.Action)
 	{
-		Player->SetState<DefaultState>();
+	case Reattach:
+		Player->GetSlimeMovement()->StartClimbing();
+		break;
+	case WrapAround:
+	{
+		Player->ApplyLocationTransition(Decision.NewLocation);
+		Player->AttachToWall(Decision.NewGravity, false);
+
+		const int32 StateIndex = Player->GetStateIndex();
+		Player->RecordTransition(StateIndex, StateIndex, ESlimeTransitionReason::WrapAround);
+		break;
+	}
+	case Fall:
+		Player->DetachFromWall();
+		Player->SetState<FallingState>(ESlimeTransitionReason::LostSurface);
+		break;
+	case Attach:
+		//The adhesion follows the gravity onto the new surface, no boost needed
+		Player->AttachToWall(Decision.NewGravity, false);
+		break;
+	case Land:
+		Player->SetState<DefaultState>(ESlimeTransitionReason::Grounded);
+		break;
+	default:
+		break;
 	}
 }
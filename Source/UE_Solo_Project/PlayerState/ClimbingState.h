@@ -8,10 +8,19 @@ class ClimbingState : public IPlayerState
 public:
 	using IPlayerState::IPlayerState; // Inherit constructors
 
-	void OnEnter() override;
-	void OnUpdate() override;
+	static void SetUpBindings(ASlimeCharacter* Player);
 
-	FName GetName() override {
+	enum EAction : uint8 { None, Reattach, WrapAround, Fall, Attach, Land };
+
+	// Landing back on the wall stops the vertical velocity
+	static constexpr EStateEvaluation Evaluation = EStateEvaluation::Distance | EStateEvaluation::Interval | EStateEvaluation::VelocitySignChange;
+
+	void OnEnter();
+	void OnExit();
+	FStateDecision Decide() const;
+	void Commit(const FStateDecision& Decision);
+
+	static FName GetName() {
 		return TEXT("CLIMBING");
 	};
 };
\ No newline at end of file
@@ -4,46 +4,54 @@
 #include "ClimbingState.h"
 #include "FallingState.h"
 
-void DefaultState::OnEnter()
+void DefaultState::SetUpBindings(ASlimeCharacter* Player)
 {
-	if (!Player->InputComponent) return;
-
-	Player->ResetBindings();
-
 	Player->SetUpBinding(Player->MoveAction, ETriggerEvent::Triggered, &ASlimeCharacter::Move);
 	Player->SetUpBinding(Player->JumpAction, ETriggerEvent::Triggered, &ASlimeCharacter::Jump);
 	Player->SetUpBinding(Player->ChargeJumpAction, ETriggerEvent::Ongoing, &ASlimeCharacter::ChargeJump);
 	Player->SetUpBinding(Player->ChargeJumpAction, ETriggerEvent::Triggered, &ASlimeCharacter::ChargeJump);
+}
 
-	Player->SetMaterialOverTime(Player->DefaultMaterial);
+void DefaultState::OnEnter()
+{
+	Player->SetMaterialOverTime(Player->DefaultMaterial.Get());
 }
 
-void DefaultState::OnUpdate()
+FStateDecision DefaultState::Decide() const
 {
-	if (Player->IsTransitioning) return;
+	const ASlimeCharacter* Slime = Player;
+	FStateDecision Decision;
 
-	if (!Player->IsPlayerGrounded())
+	if (Slime->IsTransitioning) return Decision;
+
+	if (!Slime->IsPlayerGrounded())
+	{
+		Decision.Action = Slime->HasPlayerFoundWrapAroundSurface(Decision.NewGravity, Decision.NewLocation) ? WrapAround : Fall;
+	}
+	else if (Slime->HasPlayerFoundNewSurface(Decision.NewGravity))
 	{
-		FVector NewGravity;
-		FVector NewLocation;
-		if (Player->HasPlayerFoundWrapAroundSurface(NewGravity, NewLocation))
-		{
-			Player->ApplyLocationTransition(NewLocation);
-			Player->AttachToWall(NewGravity, false);
-			Player->SetState<ClimbingState>();
-		}
-		else
-		{
-			Player->SetState<FallingState>();
-		}
+		Decision.Action = Climb;
 	}
-	else
+	return Decision;
+}
+
+void DefaultState::Commit(const FStateDecision& Decision)
+{
+	switch (Decision.Action)
 	{
-		FVector NewGravity;
-		if (Player->HasPlayerFoundNewSurface(NewGravity))
-		{
-			Player->AttachToWall(NewGravity, true);
-			Player->SetState<ClimbingState>();
-		}
+	case WrapAround:
+		Player->ApplyLocationTransition(Decision.NewLocation);
+		Player->AttachToWall(Decision.NewGravity, false);
+		Player->SetState<ClimbingState>(ESlimeTransitionReason::WrapAround);
+		break;
+	case Fall:
+		Player->SetState<FallingState>(ESlimeTransitionReason::LostSurface);
+		break;
+	case Climb:
+		Player->AttachToWall(Decision.NewGravity, true);
+		Player->SetState<ClimbingState>(ESlimeTransitionReason::FoundSurface);
+		break;
+	default:
+		break;
 	}
 }
@@ -8,10 +8,18 @@ class DefaultState : public IPlayerState
 public:
     using IPlayerState::IPlayerState; // Inherit constructors
 
-    void OnEnter() override;
-    void OnUpdate() override;
+    static void SetUpBindings(ASlimeCharacter* Player);
 
-    FName GetName() override {
+    enum EAction : uint8 { None, WrapAround, Fall, Climb };
+
+    // Surfaces only change once the slime has moved
+    static constexpr EStateEvaluation Evaluation = EStateEvaluation::Distance | EStateEvaluation::Interval;
+
+    void OnEnter();
+    FStateDecision Decide() const;
+    void Commit(const FStateDecision& Decision);
+
+    static FName GetName() {
         return TEXT("DEFAULT");
     };
 };
\ No newline at end of file
@@ -3,15 +3,14 @@
 
 #include "DefaultState.h"
 
-void FallingState::OnEnter()
+void FallingState::SetUpBindings(ASlimeCharacter* Player)
 {
-	if (!Player->InputComponent) return;
-
-	Player->ResetBindings();
-
 	Player->SetUpBinding(Player->MoveAction, ETriggerEvent::Triggered, &ASlimeCharacter::Move);
+}
 
-	Player->SetMaterialOverTime(Player->FallingMaterial);
+void FallingState::OnEnter()
+{
+	Player->SetMaterialOverTime(Player->FallingMaterial.Get());
 
 	if (Player->GetJumpVelocity() != FVector::Zero())
 	{
@@ -23,14 +22,23 @@ void FallingState::OnEnter()
 
 void FallingState::OnExit()
 {
-	Player->PlaySoundAtLocation(Player->SplatSound);
+	Player->PlaySoundAtLocation(Player->SplatSound.Get());
 }
 
-void FallingState::OnUpdate()
+FStateDecision FallingState::Decide() const
 {
-	if (Player->IsPlayerGrounded())
+	const ASlimeCharacter* Slime = Player;
+	FStateDecision Decision;
+
+	Decision.Action = Slime->IsPlayerGrounded() ? Land : None;
+	return Decision;
+}
+
+void FallingState::Commit(const FStateDecision& Decision)
+{
+	if (Decision.Action == Land)
 	{
-		Player->SetState<DefaultState>();
+		Player->SetState<DefaultState>(ESlimeTransitionReason::Landed);
 	}
 }
 
@@ -38,6 +46,6 @@ void FallingState::OnHit()
 {
 	if (Player->IsPlayerGrounded())
 	{
-		Player->SetState<DefaultState>();
+		Player->SetState<DefaultState>(ESlimeTransitionReason::Landed);
 	}
 }
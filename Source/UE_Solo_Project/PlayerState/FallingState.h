@@ -8,12 +8,20 @@ class FallingState : public IPlayerState
 public:
     using IPlayerState::IPlayerState; // Inherit constructors
 
-    void OnEnter() override;
-    void OnExit() override;
-    void OnUpdate() override;
-    void OnHit() override;
+    static void SetUpBindings(ASlimeCharacter* Player);
 
-    FName GetName() override {
+    enum EAction : uint8 { None, Land };
+
+    // No ground to find while rising, the interval catches slimes that came to rest without landing
+    static constexpr EStateEvaluation Evaluation = EStateEvaluation::OnlyWhileDescending | EStateEvaluation::VelocitySignChange | EStateEvaluation::Distance | EStateEvaluation::Interval;
+
+    void OnEnter();
+    void OnExit();
+    FStateDecision Decide() const;
+    void Commit(const FStateDecision& Decision);
+    void OnHit();
+
+    static FName GetName() {
         return TEXT("FALLING");
     };
 };
\ No newline at end of file
@@ -5,45 +5,73 @@
 #include "ClimbingState.h"
 #include "FallingState.h"
 
-void JumpingState::OnEnter()
-{
-	if (!Player->InputComponent) return;
-
-	Player->ResetBindings();
+#include "GameFramework/CharacterMovementComponent.h"
 
+void JumpingState::SetUpBindings(ASlimeCharacter* Player)
+{
 	Player->SetUpBinding(Player->MoveAction, ETriggerEvent::Triggered, &ASlimeCharacter::Move);
+}
 
-	const FVector LaunchVelocity = Player->GetJumpVelocity() * (Player->GetActorUpVector() + Player->GetActorForwardVector());
+void JumpingState::OnEnter()
+{
+	const FVector LaunchVelocity = Player->GetJumpLaunchVelocity();
+
+	//Launch velocity is added to the current velocity on the next movement update
+	Player->PredictLanding(Player->GetVelocity() + LaunchVelocity);
 
 	Player->LaunchCharacter(LaunchVelocity, false, false);
 
-	Player->PlaySoundAtLocation(Player->JumpSound);
+	Player->PlaySoundAtLocation(Player->JumpSound.Get());
 
-	Player->SetMaterialOverTime(Player->FallingMaterial);
+	Player->SetMaterialOverTime(Player->FallingMaterial.Get());
 }
 
 void JumpingState::OnExit()
 {
-	Player->PlaySoundAtLocation(Player->SplatSound);
+	Player->PlaySoundAtLocation(Player->SplatSound.Get());
 
 	Player->SetJumpVelocity(FVector::Zero());
+
+	Player->ClearLandingPrediction();
 }
 
 void JumpingState::OnHit()
 {
 	FVector NewGravity;
 
+	//Landed where the launch predicted, no need to probe for the surface
+	if (Player->ConfirmLandingPrediction(NewGravity))
+	{
+		const FVector CurrentGravity = Player->GetCharacterMovement()->GetGravityDirection();
+
+		if (!NewGravity.Equals(CurrentGravity))
+		{
+			Player->AttachToWall(NewGravity, true);
+		}
+
+		//Jumps off a wall can land back on the floor
+		if (NewGravity.Equals(FVector(0.0f, 0.0f, -1.0f)))
+		{
+			Player->SetState<DefaultState>(ESlimeTransitionReason::Landed);
+		}
+		else
+		{
+			Player->SetState<ClimbingState>(ESlimeTransitionReason::Landed);
+		}
+		return;
+	}
+
 	if (Player->HasPlayerFoundNewSurface(NewGravity))
 	{
 		Player->AttachToWall(NewGravity, true);
 
 		if (Player->IsPlayerGrounded())
 		{
-			Player->SetState<DefaultState>();
+			Player->SetState<DefaultState>(ESlimeTransitionReason::Landed);
 		}
 		else
 		{
-			Player->SetState<ClimbingState>();
+			Player->SetState<ClimbingState>(ESlimeTransitionReason::Landed);
 		}
 	}
 	else
@@ -52,17 +80,17 @@ void JumpingState::OnHit()
 		{
 			if (Player->IsPlayerGrounded())
 			{
-				Player->SetState<DefaultState>();
+				Player->SetState<DefaultState>(ESlimeTransitionReason::Landed);
 			}
 			else
 			{
-				Player->SetState<ClimbingState>();
+				Player->SetState<ClimbingState>(ESlimeTransitionReason::Landed);
 			}
 		}
 		else
 		{
 			Player->DetachFromWall();
-			Player->SetState<FallingState>();
+			Player->SetState<FallingState>(ESlimeTransitionReason::LostSurface);
 		}
 	}
 }
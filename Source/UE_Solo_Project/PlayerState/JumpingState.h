@@ -8,11 +8,16 @@ class JumpingState : public IPlayerState
 public:
     using IPlayerState::IPlayerState; // Inherit constructors
 
-    void OnEnter() override;
-    void OnExit() override;
-    void OnHit() override;
+    static void SetUpBindings(ASlimeCharacter* Player);
 
-    FName GetName() override {
+    // Landing is handled by OnHit
+    static constexpr EStateEvaluation Evaluation = EStateEvaluation::None;
+
+    void OnEnter();
+    void OnExit();
+    void OnHit();
+
+    static FName GetName() {
         return TEXT("JUMPING");
     };
 };
\ No newline at end of file
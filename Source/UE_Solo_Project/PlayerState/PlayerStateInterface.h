@@ -1,19 +1,50 @@
 
 #pragma once
 
+#include "CoreMinimal.h"
+#include "Misc/EnumClassFlags.h"
+
 class ASlimeCharacter;
 
+// When the character decides and commits a state update, OnHit is always dispatched
+enum class EStateEvaluation : uint8
+{
+    None = 0,
+    EveryFrame = 1 << 0,
+    VelocitySignChange = 1 << 1, // Velocity along gravity changed direction
+    Distance = 1 << 2, // Moved further than the character's evaluation distance
+    Interval = 1 << 3, // The character's evaluation interval elapsed
+    OnlyWhileDescending = 1 << 4 // Holds the other triggers back while moving against gravity
+};
+ENUM_CLASS_FLAGS(EStateEvaluation)
+
+// What a state decided in the read-only probe phase, applied by its Commit on the game thread
+struct FStateDecision
+{
+    int32 StateIndex = INDEX_NONE; // State that made the decision
+    uint8 Action = 0; // State specific, zero does nothing
+    FVector NewGravity = FVector::ZeroVector;
+    FVector NewLocation = FVector::ZeroVector;
+};
+
+// States are stored inline on ASlimeCharacter and dispatched statically,
+// so derived states hide these defaults rather than overriding them.
+// Decide may run on a worker thread alongside other slimes, so it only reads and probes
 class IPlayerState
 {
 public:
     IPlayerState(ASlimeCharacter* Player) : Player(Player) {};
 
-    virtual void OnEnter() {};
-    virtual void OnExit() {};
-    virtual void OnUpdate() {};
-    virtual void OnHit() {};
+    // Called once per state type when the input component is set up
+    static void SetUpBindings(ASlimeCharacter* Player) {};
+
+    static constexpr EStateEvaluation Evaluation = EStateEvaluation::EveryFrame;
 
-    virtual FName GetName() = 0;
+    void OnEnter() {};
+    void OnExit() {};
+    FStateDecision Decide() const { return {}; };
+    void Commit(const FStateDecision& Decision) {};
+    void OnHit() {};
 
 protected:
     ASlimeCharacter* Player; // Reference to Player character
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeAudioPoolComponent.h"
+
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+USlimeAudioPoolComponent::USlimeAudioPoolComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void USlimeAudioPoolComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	AActor* Owner = GetOwner();
+	if (!Owner) return;
+
+	//Create every voice up front so playing a sound never allocates
+	for (int32 Index = 0; Index < PoolSize; ++Index)
+	{
+		UAudioComponent* Voice = NewObject<UAudioComponent>(Owner);
+		Voice->bAutoActivate = false;
+		Voice->bAutoDestroy = false;
+		Voice->SetupAttachment(Owner->GetRootComponent());
+		Voice->RegisterComponent();
+
+		Voices.Add(Voice);
+		VoiceStartTimes.Add(0.0);
+	}
+}
+
+bool USlimeAudioPoolComponent::Play(USoundBase* Sound)
+{
+	if (!Sound || Voices.Num() == 0) return false;
+
+	const FSlimeCueLimits* Limits = CueLimits.Find(Sound);
+	if (!Limits)
+	{
+		Limits = &DefaultLimits;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	if (const double* LastPlayTime = LastPlayTimes.Find(Sound))
+	{
+		if (Now - *LastPlayTime < Limits->RetriggerCooldown) return false;
+	}
+
+	int32 PlayingCount = 0;
+	for (const UAudioComponent* Voice : Voices)
+	{
+		if (Voice->IsPlaying() && Voice->Sound == Sound)
+		{
+			++PlayingCount;
+		}
+	}
+	if (PlayingCount >= Limits->MaxConcurrent) return false;
+
+	const int32 VoiceIndex = FindVoice();
+	UAudioComponent* Voice = Voices[VoiceIndex];
+
+	Voice->Stop();
+	Voice->SetSound(Sound);
+	Voice->Play();
+
+	VoiceStartTimes[VoiceIndex] = Now;
+	LastPlayTimes.Add(Sound, Now);
+	return true;
+}
+
+void USlimeAudioPoolComponent::SetCueLimits(USoundBase* Sound, const FSlimeCueLimits& Limits)
+{
+	if (Sound)
+	{
+		CueLimits.Add(Sound, Limits);
+	}
+}
+
+int32 USlimeAudioPoolComponent::FindVoice() const
+{
+	//Prefer an idle voice, otherwise steal the one that has been playing longest
+	int32 OldestIndex = 0;
+	for (int32 Index = 0; Index < Voices.Num(); ++Index)
+	{
+		if (!Voices[Index]->IsPlaying())
+		{
+			return Index;
+		}
+		if (VoiceStartTimes[Index] < VoiceStartTimes[OldestIndex])
+		{
+			OldestIndex = Index;
+		}
+	}
+	return OldestIndex;
+}
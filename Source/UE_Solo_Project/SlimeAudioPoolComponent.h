@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+
+#include "SlimeAudioPoolComponent.generated.h"
+
+class UAudioComponent;
+class USoundBase;
+
+USTRUCT(BlueprintType)
+struct FSlimeCueLimits
+{
+	GENERATED_BODY()
+
+	// How many voices of the cue may play at once
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
+	int32 MaxConcurrent = 1;
+
+	// Minimum time between two triggers of the cue
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
+	float RetriggerCooldown = 0.1f;
+};
+
+// A fixed set of audio components reused for the owner's one-shot sounds
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class UE_SOLO_PROJECT_API USlimeAudioPoolComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sound")
+	int32 PoolSize = 4;
+
+	// Limits for cues without an entry in CueLimits
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
+	FSlimeCueLimits DefaultLimits;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
+	TMap<TObjectPtr<USoundBase>, FSlimeCueLimits> CueLimits;
+
+private:
+	UPROPERTY()
+	TArray<TObjectPtr<UAudioComponent>> Voices;
+
+	TArray<double> VoiceStartTimes;
+	TMap<TObjectKey<USoundBase>, double> LastPlayTimes;
+
+public:
+	USlimeAudioPoolComponent();
+
+	// Plays the sound on a pooled voice, returns false if it was limited
+	UFUNCTION(BlueprintCallable, Category = "Sound")
+	bool Play(USoundBase* Sound);
+
+	void SetCueLimits(USoundBase* Sound, const FSlimeCueLimits& Limits);
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	int32 FindVoice() const;
+};
@@ -14,42 +14,44 @@
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
 
+#include "SlimeSurfaceMath.h"
+#include "Surface/SurfaceIndexSubsystem.h"
+#include "Benchmark/SlimeInputReplaySubsystem.h"
+#include "SlimeStateMachineSubsystem.h"
+
 #include "PlayerState/DefaultState.h"
 #include "PlayerState/JumpingState.h"
 #include "PlayerState/FallingState.h"
 
 #include "Logging/LogMacros.h"
+#include "Net/UnrealNetwork.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/BlueprintGeneratedClass.h"
 
-#include "UObject/ConstructorHelpers.h"
+static const FPrimaryAssetType SlimePrimaryAssetType(TEXT("SlimeCharacter"));
 
 // Sets default values
-ASlimeCharacter::ASlimeCharacter()
+ASlimeCharacter::ASlimeCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<USlimeMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
 	SlimeMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("SlimeMesh"));
 	SlimeMesh->SetupAttachment(GetCapsuleComponent());
 	SlimeMesh->SetCollisionProfileName(TEXT("Pawn"));
 
-	static ConstructorHelpers::FObjectFinder<UStaticMesh>
-		SlimeFinder(TEXT("/Script/Engine.StaticMesh'/Game/Meshes/Slime/Slime_Slime_Body.Slime_Slime_Body'"));
-	if (SlimeMesh && SlimeFinder.Succeeded())
-	{
-		SlimeMesh->SetStaticMesh(SlimeFinder.Object);
-		SlimeMesh->SetRelativeLocation(FVector(0, 0, -65.0f));
-	}
+	SlimeMesh->SetRelativeLocation(FVector(0, 0, -65.0f));
 
 	FaceMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("FaceMesh"));
 	FaceMesh->SetupAttachment(SlimeMesh);
 	FaceMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
-	static ConstructorHelpers::FObjectFinder<UStaticMesh>
-		FaceFinder(TEXT("/Script/Engine.StaticMesh'/Game/Meshes/Slime/Slime_Slime_Face.Slime_Slime_Face'"));
-	if (FaceMesh && FaceFinder.Succeeded())
-	{
-		FaceMesh->SetStaticMesh(FaceFinder.Object);
-		FVector RelativeLocation = FVector(-53.5f, 0.0f, 63.0f);
-		FRotator RelativeRotation = FRotator(0.0f, -180.0f, 0.0f);
-		FaceMesh->SetRelativeLocationAndRotation(RelativeLocation, RelativeRotation);
-	}
+	FVector RelativeLocation = FVector(-53.5f, 0.0f, 63.0f);
+	FRotator RelativeRotation = FRotator(0.0f, -180.0f, 0.0f);
+	FaceMesh->SetRelativeLocationAndRotation(RelativeLocation, RelativeRotation);
+
+	//Meshes are streamed in at BeginPlay rather than loaded with the class
+	BodyMeshAsset = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(TEXT("/Game/Meshes/Slime/Slime_Slime_Body.Slime_Slime_Body")));
+	FaceMeshAsset = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(TEXT("/Game/Meshes/Slime/Slime_Slime_Face.Slime_Slime_Face")));
 
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(35.0f, 90.0f);
@@ -74,7 +76,7 @@ ASlimeCharacter::ASlimeCharacter()
 	GetCharacterMovement()->BrakingDecelerationFalling = 1500.0f;
 
 	// Create a camera boom (pulls in towards the player if there is a collision)
-	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
+	CameraBoom = CreateDefaultSubobject<USlimeSpringArmComponent>(TEXT("CameraBoom"));
 	CameraBoom->SetupAttachment(RootComponent);
 	CameraBoom->TargetArmLength = 400.0f; // The camera follows at this distance behind the character	
 	CameraBoom->bUsePawnControlRotation = true; // Rotate the arm based on the controller
@@ -89,6 +91,12 @@ ASlimeCharacter::ASlimeCharacter()
 	ItemLocation = CreateDefaultSubobject<USceneComponent>(TEXT("ItemLocation"));
 	ItemLocation->SetupAttachment(GetCapsuleComponent()); // Attach the boom to the capsule
 	ItemLocation->SetRelativeLocation(FVector(0.0f, 0.0f, -35.0f));
+
+	// Gravity and location transitions
+	TransitionComponent = CreateDefaultSubobject<USlimeTransitionComponent>(TEXT("TransitionComponent"));
+
+	// Pooled voices for one-shot sounds
+	AudioPool = CreateDefaultSubobject<USlimeAudioPoolComponent>(TEXT("AudioPool"));
 }
 
 // Called when the game starts or when spawned
@@ -96,13 +104,115 @@ void ASlimeCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Create and apply the dynamic material instance
-	if (DefaultMaterial)
+	SurfaceQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(SlimeSurfaceProbe), false, this);
+
+	//Every soft reference this slime holds, whichever bundle it belongs to
+	TArray<FSoftObjectPath> AssetPaths;
+	for (TFieldIterator<FSoftObjectProperty> It(GetClass()); It; ++It)
+	{
+		const FSoftObjectPath AssetPath = It->GetPropertyValue_InContainer(this).ToSoftObjectPath();
+		if (!AssetPath.IsNull())
+		{
+			AssetPaths.Add(AssetPath);
+		}
+	}
+
+	//The streamable delegate fires a frame later at the earliest, so assets that are already resident, e.g. from PreloadAssets, apply now
+	AssetLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetPaths, FStreamableDelegate());
+	if (!AssetLoadHandle || AssetLoadHandle->HasLoadCompleted())
+	{
+		OnSlimeAssetsLoaded();
+	}
+	else
+	{
+		AssetLoadHandle->BindCompleteDelegate(FStreamableDelegate::CreateUObject(this, &ASlimeCharacter::OnSlimeAssetsLoaded));
+	}
+
+	ProbeTraceDelegate.BindUObject(this, &ASlimeCharacter::OnAsyncProbeCompleted);
+
+	if (USlimeStateMachineSubsystem* StateMachineSubsystem = GetWorld()->GetSubsystem<USlimeStateMachineSubsystem>())
 	{
-		DynamicMaterialInstance = SlimeMesh->CreateDynamicMaterialInstance(0, DefaultMaterial);
+		StateMachineSubsystem->Register(this);
 	}
+	else
+	{
+		UseParallelStateUpdate = false;
+	}
+
+	if (USlimeUpdateBudgetSubsystem* UpdateBudgetSubsystem = GetWorld()->GetSubsystem<USlimeUpdateBudgetSubsystem>())
+	{
+		UpdatePhase = GetUniqueID();
+		UpdateBudgetSubsystem->Register(this);
+	}
+
 	//Add state
-	SetState<DefaultState>();
+	SetState<DefaultState>(ESlimeTransitionReason::Initial);
+}
+
+void ASlimeCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USlimeStateMachineSubsystem* StateMachineSubsystem = GetWorld()->GetSubsystem<USlimeStateMachineSubsystem>())
+	{
+		StateMachineSubsystem->Unregister(this);
+	}
+
+	if (USlimeUpdateBudgetSubsystem* UpdateBudgetSubsystem = GetWorld()->GetSubsystem<USlimeUpdateBudgetSubsystem>())
+	{
+		UpdateBudgetSubsystem->Unregister(this);
+	}
+
+	if (AssetLoadHandle)
+	{
+		AssetLoadHandle->CancelHandle();
+		AssetLoadHandle.Reset();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ASlimeCharacter::OnSlimeAssetsLoaded()
+{
+	SlimeMesh->SetStaticMesh(BodyMeshAsset.Get());
+	FaceMesh->SetStaticMesh(FaceMeshAsset.Get());
+
+	// Create and apply the dynamic material instance
+	if (UMaterialInstance* Material = DefaultMaterial.Get())
+	{
+		DynamicMaterialInstance = SlimeMesh->CreateDynamicMaterialInstance(0, Material);
+
+		//Resolve the parameters that differ between the state materials once
+		MaterialBlender.Initialize(DynamicMaterialInstance, { Material, ChargingMaterial.Get(), FallingMaterial.Get() });
+
+		//States entered before the load asked for materials that weren't there yet
+		float Alpha;
+		UMaterialInstance* StateMaterial = GetMovementStateMaterial(GetLocalRole() == ROLE_SimulatedProxy ? ReplicatedMovementState : GetPackedMovementState(), Alpha);
+		InterpolateMaterialInstances(StateMaterial, Alpha);
+	}
+
+	FSlimeCueLimits SlideLimits;
+	SlideLimits.RetriggerCooldown = SlideSoundCooldown;
+	AudioPool->SetCueLimits(SlideSound.Get(), SlideLimits);
+}
+
+FPrimaryAssetId ASlimeCharacter::GetPrimaryAssetId() const
+{
+	//Only the class default object of a slime Blueprint stands for the asset
+	if (HasAnyFlags(RF_ClassDefaultObject) && Cast<UBlueprintGeneratedClass>(GetClass()))
+	{
+		return FPrimaryAssetId(SlimePrimaryAssetType, FPackageName::GetShortFName(GetOutermost()->GetFName()));
+	}
+	return Super::GetPrimaryAssetId();
+}
+
+TSharedPtr<FStreamableHandle> ASlimeCharacter::PreloadAssets(TSubclassOf<ASlimeCharacter> SlimeClass, const TArray<FName>& Bundles, FStreamableDelegate OnLoaded)
+{
+	if (!SlimeClass) return nullptr;
+
+	//Bundle membership comes from the AssetBundles meta on each soft reference
+	const FPrimaryAssetId AssetId = SlimeClass->GetDefaultObject<ASlimeCharacter>()->GetPrimaryAssetId();
+	if (!AssetId.IsValid()) return nullptr;
+
+	return UAssetManager::Get().LoadPrimaryAsset(AssetId, Bundles, MoveTemp(OnLoaded));
 }
 
 FVector ASlimeCharacter::GetJumpVelocity()
@@ -119,45 +229,39 @@ void ASlimeCharacter::PlaySoundAtLocation(USoundCue* SoundCue)
 {
 	if (SoundCue)
 	{
-		FVector Location = GetActorLocation();
-		FRotator Rotation = GetActorRotation();
-		float VolumeMultiplier = 1.0f;
-		float PitchMultiplier = 1.0f;
-		float StartTime = 0.0f;
-
-		UGameplayStatics::PlaySoundAtLocation(this, SoundCue, Location, Rotation, VolumeMultiplier, PitchMultiplier, StartTime);
+		AudioPool->Play(SoundCue);
 	}
 }
 
-bool ASlimeCharacter::IsPlayerGrounded()
+bool ASlimeCharacter::IsPlayerGrounded() const
 {
-	FVector Down = GetActorUpVector() * -1.0f;
-	return LineTraceInDirection(Down, MaxDistanceFromSurface) && (Down == FVector(0.0f, 0.0f, -1.0f));
+	FHitResult HitResult;
+	return ProbeSurface(ESurfaceProbe::Down, HitResult) && (GetActorUpVector() * -1.0f == FVector(0.0f, 0.0f, -1.0f));
 }
 
-bool ASlimeCharacter::IsPlayerOnClimbableSurface()
+bool ASlimeCharacter::IsPlayerOnClimbableSurface() const
 {
-	FVector Down = GetActorUpVector() * -1.0f;
-	return LineTraceInDirection(Down, MaxDistanceFromSurface);
+	FHitResult HitResult;
+	return ProbeSurface(ESurfaceProbe::Down, HitResult);
 }
 
-bool ASlimeCharacter::HasPlayerFoundNewSurface(FVector& NewGravity)
+bool ASlimeCharacter::HasPlayerFoundNewSurface(FVector& NewGravity) const
 {
 	bool FoundNewSurface = false;
 
-	if (TraceForNewGravity(GetActorForwardVector(), MaxDistanceFromSurface / 2.0f, NewGravity))
+	if (TraceForNewGravity(ESurfaceProbe::Forward, NewGravity))
 	{
 		FoundNewSurface = true;
 	}
-	else if (TraceForNewGravity(GetActorUpVector(), MaxDistanceFromSurface, NewGravity))
+	else if (TraceForNewGravity(ESurfaceProbe::Up, NewGravity))
 	{
 		FoundNewSurface = true;
 	}
-	else if (TraceForNewGravity(GetActorRightVector(), MaxDistanceFromSurface / 2.0f, NewGravity))
+	else if (TraceForNewGravity(ESurfaceProbe::Right, NewGravity))
 	{
 		FoundNewSurface = true;
 	}
-	else if (TraceForNewGravity(GetActorRightVector() * -1.0f, MaxDistanceFromSurface / 2.0f, NewGravity))
+	else if (TraceForNewGravity(ESurfaceProbe::Left, NewGravity))
 	{
 		FoundNewSurface = true;
 	}
@@ -165,48 +269,47 @@ bool ASlimeCharacter::HasPlayerFoundNewSurface(FVector& NewGravity)
 	return FoundNewSurface;
 }
 
-bool ASlimeCharacter::HasPlayerFoundWrapAroundSurface(FVector& NewGravity, FVector& NewLocation)
+bool ASlimeCharacter::HasPlayerFoundWrapAroundSurface(FVector& NewGravity, FVector& NewLocation) const
 {
-	const FVector Start = GetActorLocation() + GetActorUpVector() * -200.0f;
-	const FVector End = Start + GetActorForwardVector() * -30.0f;
-
-	FCollisionQueryParams CollisionParams;
-	CollisionParams.AddIgnoredActor(this);
-
 	FHitResult HitResult;
 
-	// Perform the line trace
-	const bool bIsHit = GetWorld()->LineTraceSingleByChannel(
-		HitResult,
-		Start,
-		End,
-		ECC_GameTraceChannel1,
-		CollisionParams
-	);
+	const bool bIsHit = ProbeSurface(ESurfaceProbe::WrapAround, HitResult);
 
 	if (bIsHit)
 	{
 		//Set new gravity
 		NewGravity = HitResult.Normal * -1.0f;
 
-		SetUpMovementAxisUsingHitResult(HitResult);
-
 		//Get location to move to
-		NewLocation = HitResult.ImpactPoint + HitResult.Normal * 90.0f;
+		NewLocation = FSlimeSurfaceMath::GetWrapAroundLocation(HitResult);
 	}
 
-	//DrawDebugLine(GetWorld(), Start, End, HitResult.bBlockingHit ? FColor::Blue : FColor::Red, false, 5.0f, 0, 10.0f);
-
 	return bIsHit;
 }
 
 void ASlimeCharacter::PickUp(AItem* Item)
 {
-	if (!Item || IsHolding) return;
+	if (!Item || IsHolding || !HasAuthority()) return;
+
+	AItem* PreviousItem = HeldItem;
 
 	HeldItem = Item;
 	IsHolding = true;
 
+	OnRep_HeldItem(PreviousItem);
+}
+
+void ASlimeCharacter::OnRep_HeldItem(AItem* PreviousItem)
+{
+	//Thrown on the server, its movement replicates from here
+	if (PreviousItem && PreviousItem != HeldItem && PreviousItem->GetIsHeld())
+	{
+		PreviousItem->Release();
+		PreviousItem->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	}
+
+	if (!HeldItem) return;
+
 	HeldItem->Grab();
 
 	FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, EAttachmentRule::KeepRelative, EAttachmentRule::KeepRelative, true);
@@ -218,10 +321,131 @@ void ASlimeCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (CurrentState)
+	//Skipped time is caught up in one step once the slime is worth drawing again
+	CosmeticDeltaTime += DeltaTime;
+	if (ShouldUpdateCosmetics())
+	{
+		MaterialBlender.Update(CosmeticDeltaTime);
+		CosmeticDeltaTime = 0.0f;
+	}
+
+	if (!ShouldRunStateMachine()) return;
+
+	//Otherwise USlimeStateMachineSubsystem decides alongside the other slimes
+	if (!UseParallelStateUpdate && PrepareStateUpdate(DeltaTime))
+	{
+		CommitState(DecideState());
+	}
+
+	SurfaceQueryCacheHits = MovementMetrics.SurfaceQueryCacheHits;
+	SurfaceQueryCacheMisses = MovementMetrics.SurfaceQueryCacheMisses;
+
+	if (UseAsyncProbes && IsUpdateFrame())
+	{
+		QueueAsyncProbes();
+	}
+
+	if (HasAuthority())
+	{
+		SetReplicatedMovementState(GetPackedMovementState());
+	}
+}
+
+void ASlimeCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ASlimeCharacter, HeldItem);
+	DOREPLIFETIME(ASlimeCharacter, IsHolding);
+	DOREPLIFETIME_CONDITION(ASlimeCharacter, ReplicatedGravity, COND_SimulatedOnly);
+	DOREPLIFETIME_CONDITION(ASlimeCharacter, ReplicatedMovementState, COND_SimulatedOnly);
+}
+
+USlimeMovementComponent* ASlimeCharacter::GetSlimeMovement() const
+{
+	return Cast<USlimeMovementComponent>(GetCharacterMovement());
+}
+
+ESlimeUpdateTier ASlimeCharacter::GetUpdateTier() const
+{
+	return UpdateTier;
+}
+
+void ASlimeCharacter::SetUpdateTier(const ESlimeUpdateTier NewTier)
+{
+	UpdateTier = NewTier;
+
+	//Only a local player ever looks through the boom, no need to sweep it for anyone else's slime
+	CameraBoom->SetComponentTickEnabled(IsLocallyControlled() && IsPlayerControlled());
+}
+
+bool ASlimeCharacter::IsUpdateFrame() const
+{
+	return (GFrameCounter + UpdatePhase) % SlimeUpdateBudget::GetFrameStride(UpdateTier) == 0;
+}
+
+bool ASlimeCharacter::ShouldUpdateCosmetics() const
+{
+	return UpdateTier == ESlimeUpdateTier::Full || (UpdateTier == ESlimeUpdateTier::Reduced && IsUpdateFrame());
+}
+
+void ASlimeCharacter::GetWallMovementAxes(FVector& OutAxisX, FVector& OutAxisY) const
+{
+	OutAxisX = MovementVectorX;
+	OutAxisY = MovementVectorY;
+}
+
+bool ASlimeCharacter::ShouldRunStateMachine() const
+{
+	return IsLocallyControlled() || (HasAuthority() && !IsPlayerControlled());
+}
+
+uint16 ASlimeCharacter::GetPackedMovementState() const
+{
+	return SlimeNetQuantize::PackMovementState(GetStateIndex(), IsHolding, GetChargeFraction());
+}
+
+void ASlimeCharacter::SetReplicatedMovementState(const uint16 PackedState)
+{
+	ReplicatedMovementState = PackedState;
+	ReplicatedGravity = SlimeNetQuantize::PackGravity(GetCharacterMovement()->GetGravityDirection());
+}
+
+void ASlimeCharacter::OnRep_ReplicatedGravity()
+{
+	ApplyGravityTransition(SlimeNetQuantize::UnpackGravity(ReplicatedGravity));
+}
+
+void ASlimeCharacter::OnRep_ReplicatedMovementState()
+{
+	float Alpha;
+	UMaterialInstance* StateMaterial = GetMovementStateMaterial(ReplicatedMovementState, Alpha);
+	SetMaterialOverTime(StateMaterial, Alpha);
+}
+
+UMaterialInstance* ASlimeCharacter::GetMovementStateMaterial(const uint16 PackedState, float& OutAlpha) const
+{
+	int32 StateIndex;
+	bool Holding;
+	float Charge;
+	SlimeNetQuantize::UnpackMovementState(PackedState, StateIndex, Holding, Charge);
+
+	OutAlpha = 1.0f;
+	if (Charge > 0.0f)
 	{
-		CurrentState->OnUpdate();
+		OutAlpha = Charge;
+		return ChargingMaterial.Get();
 	}
+	if (StateIndex == TStateIndex<JumpingState, FPlayerStateStorage>::Value || StateIndex == TStateIndex<FallingState, FPlayerStateStorage>::Value)
+	{
+		return FallingMaterial.Get();
+	}
+	return DefaultMaterial.Get();
+}
+
+float ASlimeCharacter::GetChargeFraction() const
+{
+	return static_cast<float>(FMath::Max(JumpVelocity.X / SlimeCharge::MaxJumpVelocity, ThrowVelocity.X / SlimeCharge::MaxThrowVelocity));
 }
 
 // Called to bind functionality to input
@@ -238,14 +462,30 @@ void ASlimeCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComp
 	}
 
 	InputComponent = Cast<UEnhancedInputComponent>(PlayerInputComponent);
+
+	BuildBindingSets();
 }
 
-void ASlimeCharacter::ResetBindings()
+void ASlimeCharacter::BuildBindingSets()
 {
+	SLIME_MOVEMENT_SCOPE(BuildBindings);
+
+	BindingSlots.Reset();
+	for (TArray<FPointer>& BindingSet : BindingSets)
+	{
+		BindingSet.Reset();
+	}
+
 	if (!InputComponent) return;
 
-	InputComponent->ClearActionBindings();
+	BuildBindingSet<DefaultState>();
+	BuildBindingSet<JumpingState>();
+	BuildBindingSet<FallingState>();
+	BuildBindingSet<ClimbingState>();
+}
 
+void ASlimeCharacter::SetUpCommonBindings()
+{
 	SetUpBinding(LookAction, ETriggerEvent::Triggered, &ASlimeCharacter::Look);
 	SetUpBinding(ThrowAction, ETriggerEvent::Triggered, &ASlimeCharacter::Throw);
 	SetUpBinding(InteractAction, ETriggerEvent::Triggered, &ASlimeCharacter::Interact);
@@ -256,7 +496,49 @@ void ASlimeCharacter::ResetBindings()
 
 void ASlimeCharacter::SetUpBinding(const UInputAction* Action, ETriggerEvent TriggerEvent, FPointer FunctionPointer)
 {
-	InputComponent->BindAction(Action, TriggerEvent, this, FunctionPointer);
+	if (!InputComponent || BuildingBindingSet == INDEX_NONE) return;
+
+	int32 Slot = BindingSlots.IndexOfByPredicate([Action, TriggerEvent](const FInputBindingSlot& BindingSlot)
+	{
+		return BindingSlot.Action == Action && BindingSlot.TriggerEvent == TriggerEvent;
+	});
+
+	//Each action and trigger pair is only bound once, states select the callback
+	if (Slot == INDEX_NONE)
+	{
+		Slot = BindingSlots.Add({ Action, TriggerEvent });
+		for (TArray<FPointer>& BindingSet : BindingSets)
+		{
+			BindingSet.Add(nullptr);
+		}
+		InputComponent->BindAction(Action, TriggerEvent, this, &ASlimeCharacter::DispatchBinding, Slot);
+	}
+
+	BindingSets[BuildingBindingSet][Slot] = FunctionPointer;
+}
+
+void ASlimeCharacter::DispatchBinding(const FInputActionValue& Value, int32 Slot)
+{
+	if (InputReplay && BindingSlots.IsValidIndex(Slot))
+	{
+		//Live input is ignored while a recording drives the slime
+		if (InputReplay->IsReplaying()) return;
+
+		InputReplay->RecordInput(BindingSlots[Slot], Value);
+	}
+
+	InvokeBinding(Value, Slot);
+}
+
+void ASlimeCharacter::InvokeBinding(const FInputActionValue& Value, int32 Slot)
+{
+	const TArray<FPointer>& BindingSet = BindingSets[CurrentState.index()];
+	if (!BindingSet.IsValidIndex(Slot)) return;
+
+	if (const FPointer FunctionPointer = BindingSet[Slot])
+	{
+		(this->*FunctionPointer)(Value);
+	}
 }
 
 void ASlimeCharacter::Move(const FInputActionValue& Value)
@@ -265,7 +547,6 @@ void ASlimeCharacter::Move(const FInputActionValue& Value)
 
 	FVector2D MovementVector = Value.Get<FVector2D>();
 
-	GetCharacterMovement()->SetPlaneConstraintEnabled(true);
 	// find out which way is forward
 	const FRotator Rotation = Controller->GetControlRotation();
 	const FRotator YawRotation(0, Rotation.Yaw, 0);
@@ -279,8 +560,6 @@ void ASlimeCharacter::Move(const FInputActionValue& Value)
 	// add movement 
 	AddMovementInput(ForwardDirection, MovementVector.Y);
 	AddMovementInput(RightDirection, MovementVector.X);
-
-	GetCharacterMovement()->SetPlaneConstraintEnabled(false);
 }
 
 
@@ -290,12 +569,8 @@ void ASlimeCharacter::OnWallMove(const FInputActionValue& Value)
 
 	FVector2D MovementVector = Value.Get<FVector2D>();
 
-	GetCharacterMovement()->SetPlaneConstraintEnabled(true);
-
 	AddMovementInput(MovementVectorX, MovementVector.X);
 	AddMovementInput(MovementVectorY, MovementVector.Y);
-
-	GetCharacterMovement()->SetPlaneConstraintEnabled(false);
 }
 
 void ASlimeCharacter::Look(const FInputActionValue& Value)
@@ -314,58 +589,84 @@ void ASlimeCharacter::Throw(const FInputActionValue& Value)
 {
 	if (!IsHolding || !HeldItem) return;
 
-	HeldItem->Release();
-	HeldItem->DetachFromActor(FDetachmentTransformRules::KeepRelativeTransform);
-	HeldItem->SetActorLocationAndRotation(ItemLocation->GetComponentLocation(), ItemLocation->GetComponentRotation());
-
 	const FVector Impulse = ThrowVelocity * (GetActorUpVector() + GetActorForwardVector());
 
-	HeldItem->Launch(Impulse);
+	if (HasAuthority())
+	{
+		ThrowHeldItem(Impulse);
+	}
+	else
+	{
+		ServerThrowHeldItem(Impulse);
+	}
 
-	SetMaterialOverTime(DefaultMaterial);
+	SetMaterialOverTime(DefaultMaterial.Get());
 
 	ThrowVelocity = FVector::Zero();
+}
+
+void ASlimeCharacter::ThrowHeldItem(const FVector& Impulse)
+{
+	AItem* ThrownItem = HeldItem;
+
+	//IsHolding stays set until the throw cooldown finishes
+	HeldItem = nullptr;
+
+	ThrownItem->Release();
+	ThrownItem->DetachFromActor(FDetachmentTransformRules::KeepRelativeTransform);
+	ThrownItem->SetActorLocationAndRotation(ItemLocation->GetComponentLocation(), ItemLocation->GetComponentRotation());
+
+	ThrownItem->Launch(Impulse);
+
+	//Armed on the authority, IsHolding and HeldItem replicate back to the owning client
 	GetWorldTimerManager().SetTimer(TimerHandle, this, &ASlimeCharacter::OnThrowCooldownFinished, 3.0f, false);
 }
 
+void ASlimeCharacter::ServerThrowHeldItem_Implementation(const FVector_NetQuantize10& Impulse)
+{
+	if (!IsHolding || !HeldItem) return;
+
+	ThrowHeldItem(Impulse.GetClampedToMaxSize(SlimeCharge::GetMaxLaunchSpeed(SlimeCharge::MaxThrowVelocity)));
+}
+
 void ASlimeCharacter::Jump(const FInputActionValue& Value)
 {
 	if (IsTransitioning) return;
 	//Change state to jumping
-	SetState<JumpingState>();
+	SetState<JumpingState>(ESlimeTransitionReason::Input);
 }
 
 void ASlimeCharacter::ChargeJump(const FInputActionValue& Value)
 {
-	const double MinVel = 1000.0f;
-	const double MaxVel = 1300.0f;
+	const double MinVel = SlimeCharge::MinJumpVelocity;
+	const double MaxVel = SlimeCharge::MaxJumpVelocity;
 	const double ChargeRate = 500.0f;
 
 	JumpVelocity = GetChargedVelocity(JumpVelocity, MinVel, MaxVel, ChargeRate);
 
 	//Set Material Overtime
 	const float MaterialAlpha = JumpVelocity.X / MaxVel;
-	SetMaterialOverTime(ChargingMaterial, MaterialAlpha);
+	SetMaterialOverTime(ChargingMaterial.Get(), MaterialAlpha);
 }
 
 void ASlimeCharacter::ChargeThrow(const FInputActionValue& Value)
 {
 	if (!IsHolding || !HeldItem) return;
-	const double MinVel = 600.0f;
-	const double MaxVel = 800.0f;
+	const double MinVel = SlimeCharge::MinThrowVelocity;
+	const double MaxVel = SlimeCharge::MaxThrowVelocity;
 	const double ChargeRate = 50.0f;
 
 	ThrowVelocity = GetChargedVelocity(ThrowVelocity, MinVel, MaxVel, ChargeRate);
 
 	//Set Material Overtime
 	const float MaterialAlpha = ThrowVelocity.X / MaxVel;
-	SetMaterialOverTime(ChargingMaterial, MaterialAlpha);
+	SetMaterialOverTime(ChargingMaterial.Get(), MaterialAlpha);
 }
 
 void ASlimeCharacter::Detach(const FInputActionValue& Value)
 {
 	DetachFromWall();
-	SetState<FallingState>();
+	SetState<FallingState>(ESlimeTransitionReason::Input);
 }
 
 void ASlimeCharacter::Interact(const FInputActionValue& Value)
@@ -374,7 +675,155 @@ void ASlimeCharacter::Interact(const FInputActionValue& Value)
 
 void ASlimeCharacter::OnHit()
 {
-	CurrentState->OnHit();
+	if (!ShouldRunStateMachine()) return;
+
+	const int32 StateIndex = GetStateIndex();
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	{
+		SLIME_MOVEMENT_SCOPE(StateHit);
+		VisitState([](auto& State) { State.OnHit(); });
+	}
+
+	MovementMetrics.StateUpdateCycles[StateIndex] += FPlatformTime::Cycles64() - StartCycles;
+}
+
+int32 ASlimeCharacter::GetStateIndex() const
+{
+	return static_cast<int32>(CurrentState.index());
+}
+
+FName ASlimeCharacter::GetStateName(const int32 StateIndex)
+{
+	static const FName StateNames[] = { NAME_None, DefaultState::GetName(), JumpingState::GetName(), FallingState::GetName(), ClimbingState::GetName() };
+	static_assert(UE_ARRAY_COUNT(StateNames) == NumPlayerStates, "StateNames must match FPlayerStateStorage");
+
+	return (StateIndex >= 0 && StateIndex < NumPlayerStates) ? StateNames[StateIndex] : NAME_None;
+}
+
+bool ASlimeCharacter::PrepareStateUpdate(const float DeltaTime)
+{
+	//Async probes are read a frame late, so wait for the first batch before updating
+	if (UseAsyncProbes && !HasProbeResults) return false;
+
+	return ShouldEvaluateState(DeltaTime);
+}
+
+FStateDecision ASlimeCharacter::DecideState() const
+{
+	SLIME_MOVEMENT_SCOPE(StateUpdate);
+
+	const int32 StateIndex = GetStateIndex();
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	for (FHitResult& Hit : DecidingProbeHits)
+	{
+		Hit = FHitResult();
+	}
+
+	FStateDecision Decision = std::visit([](const auto& State) -> FStateDecision
+	{
+		if constexpr (std::is_same_v<std::decay_t<decltype(State)>, std::monostate>)
+		{
+			return {};
+		}
+		else
+		{
+			return State.Decide();
+		}
+	}, CurrentState);
+	Decision.StateIndex = StateIndex;
+
+	MovementMetrics.StateUpdateCycles[StateIndex] += FPlatformTime::Cycles64() - StartCycles;
+	++MovementMetrics.StateUpdateCount[StateIndex];
+
+	return Decision;
+}
+
+void ASlimeCharacter::CommitState(const FStateDecision& Decision)
+{
+	//Traced this frame whether or not the decision still applies
+	for (int32 Index = 0; Index < static_cast<int32>(ESurfaceProbe::Count); ++Index)
+	{
+		DecidedProbeHits[Index] = DecidingProbeHits[Index];
+	}
+	DecidedProbeFrame = GFrameCounter;
+
+	//Decided for a state the slime has since left
+	if (Decision.StateIndex != GetStateIndex()) return;
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	VisitState([&Decision](auto& State) { State.Commit(Decision); });
+
+	MovementMetrics.StateUpdateCycles[Decision.StateIndex] += FPlatformTime::Cycles64() - StartCycles;
+}
+
+EStateEvaluation ASlimeCharacter::GetStateEvaluation(const int32 StateIndex)
+{
+	static constexpr EStateEvaluation StateEvaluations[] = { EStateEvaluation::None, DefaultState::Evaluation, JumpingState::Evaluation, FallingState::Evaluation, ClimbingState::Evaluation };
+	static_assert(UE_ARRAY_COUNT(StateEvaluations) == NumPlayerStates, "StateEvaluations must match FPlayerStateStorage");
+
+	return (StateIndex >= 0 && StateIndex < NumPlayerStates) ? StateEvaluations[StateIndex] : EStateEvaluation::None;
+}
+
+bool ASlimeCharacter::ShouldEvaluateState(const float DeltaTime)
+{
+	const EStateEvaluation Evaluation = GetStateEvaluation(GetStateIndex());
+
+	//Sign changes are tracked every frame so none are missed between evaluations
+	const float VerticalSpeed = FVector::DotProduct(GetVelocity(), -GetCharacterMovement()->GetGravityDirection());
+	const int32 VerticalVelocitySign = FMath::Abs(VerticalSpeed) > UE_KINDA_SMALL_NUMBER ? static_cast<int32>(FMath::Sign(VerticalSpeed)) : 0;
+	const bool VelocitySignChanged = VerticalVelocitySign != LastVerticalVelocitySign;
+	LastVerticalVelocitySign = VerticalVelocitySign;
+
+	TimeSinceStateEvaluation += DeltaTime;
+
+	//A pending request always goes through. Otherwise only rising holds evaluation back, a slime at rest still has to find out it landed
+	if (!StateEvaluationPending && EnumHasAnyFlags(Evaluation, EStateEvaluation::OnlyWhileDescending) && VerticalVelocitySign > 0) return false;
+
+	bool IsDue = StateEvaluationPending || EnumHasAnyFlags(Evaluation, EStateEvaluation::EveryFrame);
+	IsDue |= EnumHasAnyFlags(Evaluation, EStateEvaluation::VelocitySignChange) && VelocitySignChanged;
+	//Slimes few players can see wait longer between evaluations
+	const float TierScale = SlimeUpdateBudget::GetFrameStride(UpdateTier);
+
+	IsDue |= EnumHasAnyFlags(Evaluation, EStateEvaluation::Interval) && TimeSinceStateEvaluation >= StateEvaluationInterval * TierScale;
+	IsDue |= EnumHasAnyFlags(Evaluation, EStateEvaluation::Distance) && FVector::DistSquared(GetActorLocation(), LastEvaluationLocation) >= FMath::Square(StateEvaluationDistance * TierScale);
+
+	if (!IsDue) return false;
+
+	StateEvaluationPending = false;
+	TimeSinceStateEvaluation = 0.0f;
+	LastEvaluationLocation = GetActorLocation();
+	return true;
+}
+
+void ASlimeCharacter::RecordTransition(const int32 FromState, const int32 ToState, const ESlimeTransitionReason Reason) const
+{
+	FSlimeTransitionRecord Record;
+	Record.Frame = GFrameCounter;
+	Record.Position = FVector3f(GetActorLocation());
+	Record.ActorId = GetUniqueID();
+	Record.FromState = static_cast<uint8>(FromState);
+	Record.ToState = static_cast<uint8>(ToState);
+	Record.Reason = Reason;
+
+	FSlimeTransitionLog::Record(Record);
+}
+
+const FSlimeMovementMetrics& ASlimeCharacter::GetMovementMetrics() const
+{
+	return MovementMetrics;
+}
+
+const TArray<FInputBindingSlot>& ASlimeCharacter::GetBindingSlots() const
+{
+	return BindingSlots;
+}
+
+void ASlimeCharacter::SetInputReplay(USlimeInputReplaySubsystem* NewInputReplay)
+{
+	InputReplay = NewInputReplay;
 }
 
 bool ASlimeCharacter::GetIsHolding()
@@ -393,99 +842,290 @@ void ASlimeCharacter::AttachToWall(const FVector& NewGravity, const bool Boost)
 	{
 		ACharacter::Jump();
 	}
-	PlaySoundAtLocation(SlideSound);
+	//Set movement direction axis for on wall movement
+	FSlimeSurfaceMath::GetMovementAxes(NewGravity * -1.0f, MovementVectorX, MovementVectorY);
+
+	PlaySoundAtLocation(SlideSound.Get());
 	ApplyGravityTransition(NewGravity);
 }
 
 void ASlimeCharacter::DetachFromWall()
 {
 	ACharacter::Jump();
-	PlaySoundAtLocation(SlideSound);
+	PlaySoundAtLocation(SlideSound.Get());
 	ApplyGravityTransition(FVector(0, 0, -1));
 }
 
-void ASlimeCharacter::LerpGravity(const FVector& NewGravityDirection, const float Alpha)
+void ASlimeCharacter::ApplyGravityTransition(const FVector& NewGravityDirection, const float PlaybackRate)
 {
-	const FVector GravityDirection = GetCharacterMovement()->GetGravityDirection();
+	SLIME_MOVEMENT_COUNT(GravityTransitions, 1);
 
-	GetCharacterMovement()->SetGravityDirection(FMath::Lerp(GravityDirection, NewGravityDirection, Alpha));
+	TransitionComponent->StartGravityTransition(NewGravityDirection, PlaybackRate);
 }
 
-void ASlimeCharacter::LerpLocation(const FVector& NewLocation, const float Alpha)
+void ASlimeCharacter::ApplyLocationTransition(const FVector& NewLocation, const float PlaybackRate)
 {
-	const FVector Location = GetActorLocation();
+	TransitionComponent->StartLocationTransition(NewLocation, PlaybackRate);
+}
 
-	SetActorLocation(FMath::Lerp(Location, NewLocation, Alpha));
+void ASlimeCharacter::LerpGravity(const FVector& NewGravityDirection, const float Alpha)
+{
+	ApplyGravityTransition(NewGravityDirection);
+}
+
+void ASlimeCharacter::LerpLocation(const FVector& NewLocation, const float Alpha)
+{
+	ApplyLocationTransition(NewLocation);
 }
 
 void ASlimeCharacter::InterpolateMaterialInstances(UMaterialInstance* NewMaterial, const float Alpha)
 {
-	UMaterialInstance* CurrentMaterial = Cast<UMaterialInstance>(SlimeMesh->GetMaterial(0));
+	MaterialBlender.Apply(NewMaterial, Alpha);
+}
 
-	if (CurrentMaterial)
-	{
-		DynamicMaterialInstance->K2_InterpolateMaterialInstanceParams(CurrentMaterial, NewMaterial, Alpha);
-	}
+void ASlimeCharacter::SetMaterialOverTime(UMaterialInstance* NewMaterial, const float Alpha)
+{
+	MaterialBlender.SetTarget(NewMaterial, Alpha, MaterialBlendDuration);
 }
 
-bool ASlimeCharacter::LineTraceInDirection(const FVector& Direction, const float LineLength, FHitResult& OutHit)
+bool ASlimeCharacter::LineTraceInDirection(const FVector& Direction, const float LineLength, FHitResult& OutHit) const
 {
 	const FVector Start = GetActorLocation();
 	const FVector End = (Start + (Direction * LineLength));
 
-	FCollisionQueryParams CollisionParams;
-	CollisionParams.AddIgnoredActor(this);
+	return LineTrace(Start, End, OutHit);
+}
+
+bool ASlimeCharacter::LineTraceInDirection(const FVector& Direction, const float LineLength) const
+{
+	FHitResult HitResult;
+	return LineTraceInDirection(Direction, LineLength, HitResult);
+}
+
+bool ASlimeCharacter::LineTrace(const FVector& Start, const FVector& End, FHitResult& OutHit) const
+{
+	SLIME_MOVEMENT_SCOPE(LineTrace);
+
+	if (const FSurfaceQueryCacheEntry* CachedQuery = FindCachedSurfaceQuery(Start, End))
+	{
+		++MovementMetrics.SurfaceQueryCacheHits;
+		OutHit = CachedQuery->HitResult;
+		return CachedQuery->IsHit;
+	}
+	++MovementMetrics.SurfaceQueryCacheMisses;
+	++MovementMetrics.TracesIssued;
+	SLIME_MOVEMENT_COUNT(TracesIssued, 1);
 
-	// Perform the line trace
-	const bool bIsHit = GetWorld()->LineTraceSingleByChannel(
-		OutHit,
-		Start,
-		End,
-		ECC_GameTraceChannel1,
-		CollisionParams
-	);
+	bool bIsHit = false;
+
+	USurfaceIndexSubsystem* SurfaceIndex = UseBakedSurfaceIndex ? GetWorld()->GetSubsystem<USurfaceIndexSubsystem>() : nullptr;
+	if (SurfaceIndex && SurfaceIndex->HasIndex())
+	{
+		OutHit = FHitResult(Start, End);
+		bIsHit = SurfaceIndex->Raycast(Start, End, OutHit);
+	}
+	else
+	{
+		// Perform the line trace
+		bIsHit = GetWorld()->LineTraceSingleByChannel(
+			OutHit,
+			Start,
+			End,
+			ECC_GameTraceChannel1,
+			SurfaceQueryParams
+		);
+	}
 
 	//DrawDebugLine(GetWorld(), Start, End, OutHit.bBlockingHit ? FColor::Blue : FColor::Red, false, 5.0f, 0, 10.0f);
 
+	SurfaceQueryCache.Add({ Start, End, OutHit, bIsHit });
+
 	return bIsHit;
 }
 
-bool ASlimeCharacter::LineTraceInDirection(const FVector& Direction, const float LineLength)
+const FSurfaceQueryCacheEntry* ASlimeCharacter::FindCachedSurfaceQuery(const FVector& Start, const FVector& End) const
 {
-	FHitResult HitResult;
-	return LineTraceInDirection(Direction, LineLength, HitResult);
+	const FVector Location = GetActorLocation();
+	const FQuat Rotation = GetActorQuat();
+
+	//Start a fresh cache each frame and whenever the actor has moved or rotated
+	if (SurfaceQueryCacheFrame != GFrameCounter || Location != SurfaceQueryCacheLocation || !Rotation.Equals(SurfaceQueryCacheRotation, 0.0f))
+	{
+		SurfaceQueryCache.Reset();
+		SurfaceQueryCacheFrame = GFrameCounter;
+		SurfaceQueryCacheLocation = Location;
+		SurfaceQueryCacheRotation = Rotation;
+		return nullptr;
+	}
+
+	for (const FSurfaceQueryCacheEntry& Entry : SurfaceQueryCache)
+	{
+		if (Entry.Start == Start && Entry.End == End)
+		{
+			return &Entry;
+		}
+	}
+	return nullptr;
 }
 
-bool ASlimeCharacter::TraceForNewGravity(const FVector& Direction, const float LineLength, FVector& NewGravity)
+void ASlimeCharacter::GetProbeSegment(const ESurfaceProbe Probe, FVector& Start, FVector& End) const
+{
+	Start = GetActorLocation();
+
+	switch (Probe)
+	{
+	case ESurfaceProbe::Down:
+		End = Start + GetActorUpVector() * -MaxDistanceFromSurface;
+		break;
+	case ESurfaceProbe::Forward:
+		End = Start + GetActorForwardVector() * (MaxDistanceFromSurface / 2.0f);
+		break;
+	case ESurfaceProbe::Up:
+		End = Start + GetActorUpVector() * MaxDistanceFromSurface;
+		break;
+	case ESurfaceProbe::Right:
+		End = Start + GetActorRightVector() * (MaxDistanceFromSurface / 2.0f);
+		break;
+	case ESurfaceProbe::Left:
+		End = Start + GetActorRightVector() * -(MaxDistanceFromSurface / 2.0f);
+		break;
+	case ESurfaceProbe::WrapAround:
+		//Look back underneath the ledge the player has walked off
+		Start += GetActorUpVector() * -200.0f;
+		End = Start + GetActorForwardVector() * -30.0f;
+		break;
+	default:
+		End = Start;
+		break;
+	}
+}
+
+bool ASlimeCharacter::ProbeSurface(const ESurfaceProbe Probe, FHitResult& OutHit) const
+{
+	if (UseAsyncProbes)
+	{
+		OutHit = ProbeResults[static_cast<int32>(Probe)];
+		return OutHit.bBlockingHit;
+	}
+
+	FVector Start;
+	FVector End;
+	GetProbeSegment(Probe, Start, End);
+
+	const bool IsHit = LineTrace(Start, End, OutHit);
+	DecidingProbeHits[static_cast<int32>(Probe)] = OutHit;
+
+	return IsHit;
+}
+
+bool ASlimeCharacter::FindProbeResult(const ESurfaceProbe Probe, FHitResult& OutHit) const
+{
+	if (UseAsyncProbes && !HasProbeResults) return false;
+
+	//Stale planes can be ones the slime has since moved away from
+	const uint64 ResultsFrame = UseAsyncProbes ? ProbeResultsFrame : DecidedProbeFrame;
+	if (GFrameCounter - ResultsFrame > 1) return false;
+
+	OutHit = UseAsyncProbes ? ProbeResults[static_cast<int32>(Probe)] : DecidedProbeHits[static_cast<int32>(Probe)];
+	return OutHit.bBlockingHit;
+}
+
+void ASlimeCharacter::QueueAsyncProbes()
+{
+	MovementMetrics.TracesIssued += static_cast<uint32>(ESurfaceProbe::Count);
+	SLIME_MOVEMENT_COUNT(TracesIssued, static_cast<uint32>(ESurfaceProbe::Count));
+
+	for (int32 Index = 0; Index < static_cast<int32>(ESurfaceProbe::Count); ++Index)
+	{
+		FVector Start;
+		FVector End;
+		GetProbeSegment(static_cast<ESurfaceProbe>(Index), Start, End);
+
+		GetWorld()->AsyncLineTraceByChannel(
+			EAsyncTraceType::Single,
+			Start,
+			End,
+			ECC_GameTraceChannel1,
+			SurfaceQueryParams,
+			FCollisionResponseParams::DefaultResponseParam,
+			&ProbeTraceDelegate,
+			Index
+		);
+	}
+}
+
+void ASlimeCharacter::OnAsyncProbeCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceData)
+{
+	if (TraceData.UserData >= static_cast<uint32>(ESurfaceProbe::Count)) return;
+
+	ProbeResults[TraceData.UserData] = TraceData.OutHits.Num() > 0 ? TraceData.OutHits[0] : FHitResult();
+	HasProbeResults = true;
+	ProbeResultsFrame = GFrameCounter;
+}
+
+bool ASlimeCharacter::TraceForNewGravity(const ESurfaceProbe Probe, FVector& NewGravity) const
 {
 	FHitResult HitResult;
-	const bool HasHit = LineTraceInDirection(Direction, LineLength, HitResult);
+	const bool HasHit = ProbeSurface(Probe, HitResult);
 	if (HasHit)
 	{
 		//Set new gravity
 		NewGravity = HitResult.Normal * -1.0f;
-
-		SetUpMovementAxisUsingHitResult(HitResult);
 	}
 	return HasHit;
 }
 
-void ASlimeCharacter::OnThrowCooldownFinished()
+FVector ASlimeCharacter::GetJumpLaunchVelocity()
 {
-	IsHolding = false;
-	HeldItem = nullptr;
+	return JumpVelocity * (GetActorUpVector() + GetActorForwardVector());
 }
 
-void ASlimeCharacter::SetUpMovementAxisUsingHitResult(const FHitResult& HitResult)
+void ASlimeCharacter::PredictLanding(const FVector& Velocity)
 {
-	//Recalculate right vector
-	FVector RightVector = FVector::CrossProduct(FVector::UpVector, HitResult.Normal);
-	//Recalculate forward vector
-	FVector ForwardVector = FVector::CrossProduct(HitResult.Normal, RightVector);
+	const FVector Gravity = GetCharacterMovement()->GetGravityDirection() * FMath::Abs(GetCharacterMovement()->GetGravityZ());
 
-	//Set movement direction axis for on wall movement
-	MovementVectorX = RightVector * -1.0f;
-	MovementVectorY = ForwardVector;
+	FSlimeTrajectory::PredictLanding(GetWorld(), GetActorLocation(), Velocity, Gravity, SurfaceQueryParams, LandingPrediction);
+}
+
+bool ASlimeCharacter::ConfirmLandingPrediction(FVector& NewGravity)
+{
+	if (!LandingPrediction.IsValid) return false;
+
+	//Only trust the prediction if the hit happened where it was expected
+	if (FVector::DistSquared(GetActorLocation(), LandingPrediction.Location) > FMath::Square(LandingPredictionTolerance)) return false;
+
+	//Items and props grazed near the landing point also end up here, so check the predicted surface is what's under the slime
+	FHitResult SurfaceHit;
+	const float TraceLength = GetCapsuleComponent()->GetScaledCapsuleRadius() + LandingPredictionTolerance;
+	if (!LineTraceInDirection(-LandingPrediction.Normal, TraceLength, SurfaceHit)) return false;
+
+	const double PlaneDistance = FMath::Abs((SurfaceHit.ImpactPoint - LandingPrediction.Location) | LandingPrediction.Normal);
+	if ((SurfaceHit.ImpactNormal | LandingPrediction.Normal) < 0.99 || PlaneDistance > 10.0) return false;
+
+	NewGravity = LandingPrediction.NewGravity;
+	MovementVectorX = LandingPrediction.MovementVectorX;
+	MovementVectorY = LandingPrediction.MovementVectorY;
+	return true;
+}
+
+void ASlimeCharacter::ClearLandingPrediction()
+{
+	LandingPrediction = FSlimeLandingPrediction();
+}
+
+bool ASlimeCharacter::GetChargeJumpArc(TArray<FVector>& OutPoints)
+{
+	const FVector Gravity = GetCharacterMovement()->GetGravityDirection() * FMath::Abs(GetCharacterMovement()->GetGravityZ());
+	const FVector Velocity = GetVelocity() + GetJumpLaunchVelocity();
+
+	FSlimeLandingPrediction Prediction;
+	return FSlimeTrajectory::PredictLanding(GetWorld(), GetActorLocation(), Velocity, Gravity, SurfaceQueryParams, Prediction, &OutPoints);
+}
+
+void ASlimeCharacter::OnThrowCooldownFinished()
+{
+	IsHolding = false;
+	HeldItem = nullptr;
 }
 
 FVector ASlimeCharacter::GetChargedVelocity(const FVector& CurrentVelocity, const float MinVel, const float MaxVel, const float ChargeRate)
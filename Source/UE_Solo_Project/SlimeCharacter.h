@@ -2,11 +2,10 @@
 
 #pragma once
 
-#include <memory>
+#include <variant>
 #include "CoreMinimal.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/Character.h"
-#include "GameFramework/SpringArmComponent.h"
 
 #include "Kismet/KismetSystemLibrary.h"
 #include "Kismet/KismetMaterialLibrary.h"
@@ -22,15 +21,101 @@
 #include "Engine/World.h"
 
 #include "Sound/SoundCue.h"
+#include "Engine/StreamableManager.h"
 
 #include "PlayerState/PlayerStateInterface.h"
+#include "PlayerState/DefaultState.h"
+#include "PlayerState/JumpingState.h"
+#include "PlayerState/FallingState.h"
+#include "PlayerState/ClimbingState.h"
 #include "Item.h"
+#include "SlimeTrajectory.h"
+#include "SlimeTransitionComponent.h"
+#include "SlimeMaterialBlender.h"
+#include "SlimeAudioPoolComponent.h"
+#include "SlimeTransitionLog.h"
+#include "SlimeMovementStats.h"
+#include "SlimeMovementComponent.h"
+#include "SlimeUpdateBudgetSubsystem.h"
+#include "SlimeSpringArmComponent.h"
 
 #include "SlimeCharacter.generated.h"
 
+class USlimeInputReplaySubsystem;
+
 template <typename T>
 concept InheritsPlayerState = std::is_base_of<IPlayerState, T>::value;
 
+// Inline storage for the current state, no state is set before BeginPlay
+using FPlayerStateStorage = std::variant<std::monostate, DefaultState, JumpingState, FallingState, ClimbingState>;
+
+constexpr int32 NumPlayerStates = std::variant_size_v<FPlayerStateStorage>;
+
+// Compile time index of a state within FPlayerStateStorage
+template<typename T, typename VariantType>
+struct TStateIndex;
+
+template<typename T, typename... Types>
+struct TStateIndex<T, std::variant<Types...>>
+{
+	static constexpr int32 Value = []
+	{
+		constexpr bool Matches[] = { std::is_same_v<T, Types>... };
+		int32 Index = 0;
+		while (!Matches[Index])
+		{
+			++Index;
+		}
+		return Index;
+	}();
+};
+
+// Running totals used by the movement benchmark
+struct FSlimeMovementMetrics
+{
+	uint64 StateUpdateCycles[NumPlayerStates] = {};
+	uint32 StateUpdateCount[NumPlayerStates] = {};
+	uint32 TracesIssued = 0;
+	uint32 Transitions = 0;
+	uint32 SurfaceQueryCacheHits = 0;
+	uint32 SurfaceQueryCacheMisses = 0;
+};
+
+// An action and trigger event bound once on the input component
+struct FInputBindingSlot
+{
+	const UInputAction* Action;
+	ETriggerEvent TriggerEvent;
+};
+
+// Rays the state machine uses to find and follow climbable surfaces
+enum class ESurfaceProbe : uint8
+{
+	Down,
+	Forward,
+	Up,
+	Right,
+	Left,
+	WrapAround,
+	Count
+};
+
+// Asset bundles a slime's soft references are grouped into, for ASlimeCharacter::PreloadAssets
+namespace SlimeAssetBundles
+{
+	inline const FName Visual(TEXT("Visual"));
+	inline const FName Audio(TEXT("Audio"));
+}
+
+// A surface query made this frame, reused until the actor moves or rotates
+struct FSurfaceQueryCacheEntry
+{
+	FVector Start;
+	FVector End;
+	FHitResult HitResult;
+	bool IsHit;
+};
+
 UCLASS()
 class UE_SOLO_PROJECT_API ASlimeCharacter : public ACharacter
 {
@@ -45,9 +130,16 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
 	UStaticMeshComponent* FaceMesh;
 
+	// Streamed in at BeginPlay and applied to SlimeMesh and FaceMesh
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Mesh", meta = (AssetBundles = "Visual"))
+	TSoftObjectPtr<UStaticMesh> BodyMeshAsset;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Mesh", meta = (AssetBundles = "Visual"))
+	TSoftObjectPtr<UStaticMesh> FaceMeshAsset;
+
 	//Camera
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera")
-	USpringArmComponent* CameraBoom;
+	USlimeSpringArmComponent* CameraBoom;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera")
 	UCameraComponent* FollowCamera;
@@ -81,56 +173,104 @@ public:
 	UInputAction* ChargeThrowAction;
 
 	//Sounds
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound")
-	USoundCue* JumpSound;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound", meta = (AssetBundles = "Audio"))
+	TSoftObjectPtr<USoundCue> JumpSound;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound")
-	USoundCue* PopSound;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound", meta = (AssetBundles = "Audio"))
+	TSoftObjectPtr<USoundCue> PopSound;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound")
-	USoundCue* DetachSound;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound", meta = (AssetBundles = "Audio"))
+	TSoftObjectPtr<USoundCue> DetachSound;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound")
-	USoundCue* SlideSound;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound", meta = (AssetBundles = "Audio"))
+	TSoftObjectPtr<USoundCue> SlideSound;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound", meta = (AssetBundles = "Audio"))
+	TSoftObjectPtr<USoundCue> SplatSound;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Sound")
+	USlimeAudioPoolComponent* AudioPool;
+
+	// Slide is replayed on every new surface, so it gets a longer cooldown than other cues
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Sound")
-	USoundCue* SplatSound;
+	float SlideSoundCooldown = 0.5f;
 
 	//Materials
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Material")
 	UMaterialInstanceDynamic* DynamicMaterialInstance;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Material")
-	UMaterialInstance* DefaultMaterial;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Material", meta = (AssetBundles = "Visual"))
+	TSoftObjectPtr<UMaterialInstance> DefaultMaterial;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Material")
-	UMaterialInstance* ChargingMaterial;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Material", meta = (AssetBundles = "Visual"))
+	TSoftObjectPtr<UMaterialInstance> ChargingMaterial;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Material", meta = (AssetBundles = "Visual"))
+	TSoftObjectPtr<UMaterialInstance> FallingMaterial;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Material")
-	UMaterialInstance* FallingMaterial;
+	float MaterialBlendDuration = 0.25f;
 
 
+	//Transitions
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Transition")
+	USlimeTransitionComponent* TransitionComponent;
+
 	//Item
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
 	USceneComponent* ItemLocation;
 
+	UPROPERTY(ReplicatedUsing = OnRep_HeldItem)
 	AItem* HeldItem;
 
 	//Variables
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Replicated)
 	bool IsHolding = false;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
 	bool IsTransitioning = false;
 
+	//Probing
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Probing")
+	bool UseAsyncProbes = false;
+
+	// Decide the state update in parallel with other slimes through USlimeStateMachineSubsystem
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "State")
+	bool UseParallelStateUpdate = true;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Probing")
+	int32 SurfaceQueryCacheHits = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Probing")
+	int32 SurfaceQueryCacheMisses = 0;
+
+	// Answer synchronous surface probes from the baked climbable-surface index when the map has one
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Probing")
+	bool UseBakedSurfaceIndex = false;
+
+	// How far from the predicted landing point a hit still confirms the prediction
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Probing")
+	float LandingPredictionTolerance = 150.0f;
+
+	//State evaluation
+	// Longest time a state waits between updates when it evaluates on an interval
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "State")
+	float StateEvaluationInterval = 0.25f;
+
+	// Distance moved before a state that evaluates on distance is updated
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "State")
+	float StateEvaluationDistance = 25.0f;
+
 	FTimerHandle TimerHandle;
 
 	UEnhancedInputComponent* InputComponent;
 
+	typedef void (ASlimeCharacter::* FPointer)(const FInputActionValue&);
+
 private:
 
-	std::unique_ptr<IPlayerState> CurrentState;
+	FPlayerStateStorage CurrentState;
 
 	float PickUpCooldown;
 	float JumpCooldown;
@@ -142,38 +282,140 @@ private:
 	FVector MovementVectorX;
 	FVector MovementVectorY;
 
+	//Results of the previous frame's async probe batch
+	FHitResult ProbeResults[static_cast<int32>(ESurfaceProbe::Count)];
+	FTraceDelegate ProbeTraceDelegate;
+	bool HasProbeResults = false;
+	uint64 ProbeResultsFrame = 0;
+
+	//Per-frame cache of synchronous surface queries, only touched by the thread deciding this slime's state
+	mutable TArray<FSurfaceQueryCacheEntry, TInlineAllocator<8>> SurfaceQueryCache;
+	mutable uint64 SurfaceQueryCacheFrame = 0;
+	mutable FVector SurfaceQueryCacheLocation;
+	mutable FQuat SurfaceQueryCacheRotation;
+
+	//Synchronous probe hits of the decision in flight, only touched by the thread deciding this slime's state
+	mutable FHitResult DecidingProbeHits[static_cast<int32>(ESurfaceProbe::Count)];
+	//Published by CommitState on the game thread, probes the last decision didn't trace are left without a hit
+	FHitResult DecidedProbeHits[static_cast<int32>(ESurfaceProbe::Count)];
+	uint64 DecidedProbeFrame = 0;
+	FCollisionQueryParams SurfaceQueryParams;
+
+	//Input bindings are built once per state and selected by the current state index
+	TArray<FInputBindingSlot> BindingSlots;
+	TArray<FPointer> BindingSets[NumPlayerStates];
+	int32 BuildingBindingSet = INDEX_NONE;
+
+	//Records or replaces live input while an input recording runs
+	USlimeInputReplaySubsystem* InputReplay = nullptr;
+
+	mutable FSlimeMovementMetrics MovementMetrics;
+
+	//Bookkeeping for when the current state is next updated
+	bool StateEvaluationPending = true;
+	float TimeSinceStateEvaluation = 0.0f;
+	FVector LastEvaluationLocation = FVector::ZeroVector;
+	int32 LastVerticalVelocitySign = 0;
+
+	//Set by USlimeUpdateBudgetSubsystem from how visible the slime is in the local views
+	ESlimeUpdateTier UpdateTier = ESlimeUpdateTier::Full;
+	uint32 UpdatePhase = 0;
+	float CosmeticDeltaTime = 0.0f;
+
+	FSlimeLandingPrediction LandingPrediction;
+
+	FSlimeMaterialBlender MaterialBlender;
+
+	//Keeps the streamed meshes, materials and cues loaded for as long as the slime is alive
+	TSharedPtr<FStreamableHandle> AssetLoadHandle;
+
+	//Movement state for simulated proxies, the owning client sends its own with each move
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedGravity)
+	uint32 ReplicatedGravity = 0;
+
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedMovementState)
+	uint16 ReplicatedMovementState = 0;
+
 	// ----------- Methods -----------
 private:
 
 	void OnThrowCooldownFinished();
 
-	void SetUpMovementAxisUsingHitResult(const FHitResult& HitResult);
-
 	FVector GetChargedVelocity(const FVector& CurrentVelocity, const float MinVel, const float MaxVel, const float ChargeRate);
 
-	bool LineTraceInDirection(const FVector& Direction, const float LineLength, FHitResult& OutHit);
+	bool LineTraceInDirection(const FVector& Direction, const float LineLength, FHitResult& OutHit) const;
+
+	bool LineTraceInDirection(const FVector& Direction, const float LineLength) const;
+
+	bool LineTrace(const FVector& Start, const FVector& End, FHitResult& OutHit) const;
+
+	void GetProbeSegment(const ESurfaceProbe Probe, FVector& Start, FVector& End) const;
+
+	bool ProbeSurface(const ESurfaceProbe Probe, FHitResult& OutHit) const;
+
+	// Queues one async line trace per ESurfaceProbe rather than a single batched query. The probes point in
+	// different directions and each needs its own first hit, which one overlap or sweep can't return.
+	// They share a delegate and complete together in the next frame's async trace batch
+	void QueueAsyncProbes();
+
+	const FSurfaceQueryCacheEntry* FindCachedSurfaceQuery(const FVector& Start, const FVector& End) const;
+
+	void OnAsyncProbeCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceData);
 
-	bool LineTraceInDirection(const FVector& Direction, const float LineLength);
+	float GetChargeFraction() const;
+
+	bool ShouldEvaluateState(const float DeltaTime);
+
+	void ThrowHeldItem(const FVector& Impulse);
+
+	UFUNCTION(Server, Reliable)
+	void ServerThrowHeldItem(const FVector_NetQuantize10& Impulse);
+
+	UFUNCTION()
+	void OnRep_HeldItem(AItem* PreviousItem);
+
+	UFUNCTION()
+	void OnRep_ReplicatedGravity();
+
+	UFUNCTION()
+	void OnRep_ReplicatedMovementState();
+
+	// Material and blend alpha a packed movement state shows
+	UMaterialInstance* GetMovementStateMaterial(const uint16 PackedState, float& OutAlpha) const;
 
 protected:
 
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	void OnSlimeAssetsLoaded();
+
 public:
 
 	// Sets default values for this character's properties
-	ASlimeCharacter();
+	ASlimeCharacter(const FObjectInitializer& ObjectInitializer);
 
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// Slime Blueprints are primary assets, so the asset manager can load a variant's bundles before it spawns
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	// Streams a slime variant's bundles ahead of spawning it, e.g. from the game mode while the level loads.
+	// Keep the handle for as long as the assets should stay resident
+	static TSharedPtr<FStreamableHandle> PreloadAssets(TSubclassOf<ASlimeCharacter> SlimeClass, const TArray<FName>& Bundles, FStreamableDelegate OnLoaded = FStreamableDelegate());
+
 	// ----------- UFUNCTIONS -----------
 
-	UFUNCTION(BlueprintCallable)
+	// Old timeline entry points, forwarded to the transition component which does the blending. Alpha is ignored
+	UFUNCTION(BlueprintCallable, meta = (DeprecatedFunction, DeprecationMessage = "Use ApplyGravityTransition, the transition component blends over time"))
 	void LerpGravity(const FVector& NewGravityDirection, const float Alpha);
 
-	UFUNCTION(BlueprintCallable)
+	UFUNCTION(BlueprintCallable, meta = (DeprecatedFunction, DeprecationMessage = "Use ApplyLocationTransition, the transition component blends over time"))
 	void LerpLocation(const FVector& NewLocation, const float Alpha);
 
 	UFUNCTION(BlueprintCallable)
@@ -182,14 +424,18 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void OnHit();
 
-	// Timeline Events
-	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
+	// Arc the current charged jump would follow, for previewing while charging
+	UFUNCTION(BlueprintCallable)
+	bool GetChargeJumpArc(TArray<FVector>& OutPoints);
+
+	// Transitions
+	UFUNCTION(BlueprintCallable)
 	void ApplyGravityTransition(const FVector& NewGravityDirection, const float PlaybackRate = 1.0f);
 
-	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
+	UFUNCTION(BlueprintCallable)
 	void ApplyLocationTransition(const FVector& NewLocation, const float PlaybackRate = 1.0f);
 
-	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
+	UFUNCTION(BlueprintCallable)
 	void SetMaterialOverTime(UMaterialInstance* NewMaterial, const float Alpha = 1.0f);
 
 	// Methods
@@ -202,20 +448,85 @@ public:
 
 	void SetIsHolding(const bool Holding);
 
-	template<typename InheritsPlayerState>
-	void SetState();
+	template<InheritsPlayerState T>
+	void SetState(const ESlimeTransitionReason Reason = ESlimeTransitionReason::Other);
+
+	void RecordTransition(const int32 FromState, const int32 ToState, const ESlimeTransitionReason Reason) const;
+
+	template<InheritsPlayerState T>
+	bool IsInState() const;
+
+	int32 GetStateIndex() const;
+
+	static FName GetStateName(const int32 StateIndex);
+
+	static EStateEvaluation GetStateEvaluation(const int32 StateIndex);
+
+	const FSlimeMovementMetrics& GetMovementMetrics() const;
+
+	// States only run where the slime is controlled, other machines follow the replicated state
+	bool ShouldRunStateMachine() const;
+
+	USlimeMovementComponent* GetSlimeMovement() const;
+
+	ESlimeUpdateTier GetUpdateTier() const;
+
+	void SetUpdateTier(const ESlimeUpdateTier NewTier);
+
+	// True on the frames a reduced tier slime probes, slimes are staggered so they don't all land on the same frame
+	bool IsUpdateFrame() const;
+
+	bool ShouldUpdateCosmetics() const;
+
+	// Directions OnWallMove's X and Y drive the slime in while it is on a wall
+	void GetWallMovementAxes(FVector& OutAxisX, FVector& OutAxisY) const;
+
+	uint16 GetPackedMovementState() const;
+
+	void SetReplicatedMovementState(const uint16 PackedState);
+
+	const TArray<FInputBindingSlot>& GetBindingSlots() const;
+
+	void SetInputReplay(USlimeInputReplaySubsystem* NewInputReplay);
+
+	// Runs the current state's callback for a binding slot, bypassing recording
+	void InvokeBinding(const FInputActionValue& Value, int32 Slot);
+
+	template<typename FunctionType>
+	void VisitState(FunctionType&& Function);
 
 	void PlaySoundAtLocation(USoundCue* SoundCue);
 
-	bool IsPlayerGrounded();
+	// Probes only read the world, so they can run while other slimes decide in parallel
+
+	bool IsPlayerGrounded() const;
+
+	bool IsPlayerOnClimbableSurface() const;
+
+	bool HasPlayerFoundNewSurface(FVector& NewGravity) const;
+
+	bool HasPlayerFoundWrapAroundSurface(FVector& NewGravity, FVector& NewLocation) const;
 
-	bool IsPlayerOnClimbableSurface();
+	bool TraceForNewGravity(const ESurfaceProbe Probe, FVector& NewGravity) const;
 
-	bool HasPlayerFoundNewSurface(FVector& NewGravity);
+	// A probe's hit from a state decision or async batch no older than the previous frame, never issues a query.
+	// Slimes on a reduced update tier go several frames between probes and find nothing in between
+	bool FindProbeResult(const ESurfaceProbe Probe, FHitResult& OutHit) const;
 
-	bool HasPlayerFoundWrapAroundSurface(FVector& NewGravity, FVector& NewLocation);
+	// Game thread, true when the state should be decided and committed this frame
+	bool PrepareStateUpdate(const float DeltaTime);
 
-	bool TraceForNewGravity(const FVector& Direction, const float LineLength, FVector& NewGravity);
+	FStateDecision DecideState() const;
+
+	void CommitState(const FStateDecision& Decision);
+
+	FVector GetJumpLaunchVelocity();
+
+	void PredictLanding(const FVector& Velocity);
+
+	bool ConfirmLandingPrediction(FVector& NewGravity);
+
+	void ClearLandingPrediction();
 
 	UFUNCTION(BlueprintCallable)
 	void PickUp(AItem* Item);
@@ -228,12 +539,17 @@ public:
 
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
-	typedef void (ASlimeCharacter::* FPointer)(const FInputActionValue&);
+	void BuildBindingSets();
 
-	void ResetBindings();
+	template<InheritsPlayerState T>
+	void BuildBindingSet();
+
+	void SetUpCommonBindings();
 
 	void SetUpBinding(const UInputAction* Action, ETriggerEvent TriggerEvent, FPointer FunctionName);
 
+	void DispatchBinding(const FInputActionValue& Value, int32 Slot);
+
 	// Input Callbacks
 
 	void Move(const FInputActionValue& Value);
@@ -256,17 +572,50 @@ public:
 
 };
 
-template<typename InheritsPlayerState>
-inline void ASlimeCharacter::SetState()
+template<InheritsPlayerState T>
+inline void ASlimeCharacter::SetState(const ESlimeTransitionReason Reason)
 {
-	if (CurrentState)
-	{
-		CurrentState->OnExit();
-	}
-	CurrentState = std::make_unique<InheritsPlayerState>(this);
+	SLIME_MOVEMENT_SCOPE(SetState);
+	SLIME_MOVEMENT_COUNT(Transitions, 1);
+
+	VisitState([](auto& State) { State.OnExit(); });
+
+	const int32 PreviousState = GetStateIndex();
+
+	T& NewState = CurrentState.template emplace<T>(this);
+	++MovementMetrics.Transitions;
+	StateEvaluationPending = true;
+
+	RecordTransition(PreviousState, GetStateIndex(), Reason);
+
+	NewState.OnEnter();
+};
+
+template<InheritsPlayerState T>
+inline bool ASlimeCharacter::IsInState() const
+{
+	return std::holds_alternative<T>(CurrentState);
+};
+
+template<InheritsPlayerState T>
+inline void ASlimeCharacter::BuildBindingSet()
+{
+	BuildingBindingSet = TStateIndex<T, FPlayerStateStorage>::Value;
 
-	FString NameString = CurrentState->GetName().ToString();
-	UE_LOG(LogTemp, Warning, TEXT("New State : % s"), *NameString);
+	SetUpCommonBindings();
+	T::SetUpBindings(this);
 
-	CurrentState->OnEnter();
+	BuildingBindingSet = INDEX_NONE;
+};
+
+template<typename FunctionType>
+inline void ASlimeCharacter::VisitState(FunctionType&& Function)
+{
+	std::visit([&Function](auto& State)
+	{
+		if constexpr (!std::is_same_v<std::decay_t<decltype(State)>, std::monostate>)
+		{
+			Function(State);
+		}
+	}, CurrentState);
 };
@@ -0,0 +1,235 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeMaterialBlender.h"
+
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialInterface.h"
+
+void FSlimeMaterialBlender::Initialize(UMaterialInstanceDynamic* InDynamicMaterial, const TArray<UMaterialInterface*>& Materials)
+{
+	DynamicMaterial = InDynamicMaterial;
+	ScalarNames.Reset();
+	ScalarIndices.Reset();
+	VectorNames.Reset();
+	VectorIndices.Reset();
+	Poses.Reset();
+	Blending = false;
+	TargetMaterial = nullptr;
+	TargetAlpha = -1.0f;
+
+	if (!InDynamicMaterial || Materials.Num() == 0 || !Materials[0]) return;
+
+	//Gather every parameter any of the materials exposes
+	TArray<FMaterialParameterInfo> ParameterInfos;
+	TArray<FGuid> ParameterIds;
+	TSet<FName> CandidateScalars;
+	TSet<FName> CandidateVectors;
+
+	for (const UMaterialInterface* Material : Materials)
+	{
+		if (!Material) continue;
+
+		Material->GetAllScalarParameterInfo(ParameterInfos, ParameterIds);
+		for (const FMaterialParameterInfo& Info : ParameterInfos)
+		{
+			CandidateScalars.Add(Info.Name);
+		}
+
+		Material->GetAllVectorParameterInfo(ParameterInfos, ParameterIds);
+		for (const FMaterialParameterInfo& Info : ParameterInfos)
+		{
+			CandidateVectors.Add(Info.Name);
+		}
+	}
+
+	//Keep only the parameters whose values differ between the materials
+	for (const FName& Name : CandidateScalars)
+	{
+		float BaseValue = 0.0f;
+		Materials[0]->GetScalarParameterValue(Name, BaseValue);
+
+		bool Differs = false;
+		for (const UMaterialInterface* Material : Materials)
+		{
+			float Value = BaseValue;
+			if (Material && Material->GetScalarParameterValue(Name, Value) && !FMath::IsNearlyEqual(Value, BaseValue))
+			{
+				Differs = true;
+				break;
+			}
+		}
+
+		if (Differs)
+		{
+			int32 ParameterIndex = INDEX_NONE;
+			InDynamicMaterial->InitializeScalarParameterAndGetIndex(Name, BaseValue, ParameterIndex);
+			ScalarNames.Add(Name);
+			ScalarIndices.Add(ParameterIndex);
+		}
+	}
+
+	for (const FName& Name : CandidateVectors)
+	{
+		FLinearColor BaseValue = FLinearColor::Black;
+		Materials[0]->GetVectorParameterValue(Name, BaseValue);
+
+		bool Differs = false;
+		for (const UMaterialInterface* Material : Materials)
+		{
+			FLinearColor Value = BaseValue;
+			if (Material && Material->GetVectorParameterValue(Name, Value) && !Value.Equals(BaseValue))
+			{
+				Differs = true;
+				break;
+			}
+		}
+
+		if (Differs)
+		{
+			int32 ParameterIndex = INDEX_NONE;
+			InDynamicMaterial->InitializeVectorParameterAndGetIndex(Name, BaseValue, ParameterIndex);
+			VectorNames.Add(Name);
+			VectorIndices.Add(ParameterIndex);
+		}
+	}
+
+	//Snapshot each material's values for the blended parameters
+	for (const UMaterialInterface* Material : Materials)
+	{
+		if (!Material || FindPose(Material)) continue;
+
+		FSlimeMaterialPose& Pose = Poses.AddDefaulted_GetRef();
+		Pose.Material = Material;
+
+		for (const FName& Name : ScalarNames)
+		{
+			float Value = 0.0f;
+			Material->GetScalarParameterValue(Name, Value);
+			Pose.Scalars.Add(Value);
+		}
+
+		for (const FName& Name : VectorNames)
+		{
+			FLinearColor Value = FLinearColor::Black;
+			Material->GetVectorParameterValue(Name, Value);
+			Pose.Vectors.Add(Value);
+		}
+	}
+
+	Current = Poses[0];
+}
+
+void FSlimeMaterialBlender::SetTarget(const UMaterialInterface* Material, const float Alpha, const float InDuration)
+{
+	//Repeated requests for the same target keep the running blend
+	if (Material == TargetMaterial && FMath::IsNearlyEqual(Alpha, TargetAlpha)) return;
+
+	if (!BuildTarget(Material, Alpha, Target)) return;
+
+	TargetAlpha = Alpha;
+
+	//Only the alpha moved, e.g. every tick while charging. A running blend heads for the new values without
+	//starting over, a finished one follows them straight away
+	if (Material == TargetMaterial)
+	{
+		if (!Blending)
+		{
+			Start = Current;
+			Push(1.0f);
+		}
+		return;
+	}
+
+	TargetMaterial = Material;
+
+	Start = Current;
+	Elapsed = 0.0f;
+	Duration = InDuration;
+	Blending = true;
+
+	if (Duration <= 0.0f)
+	{
+		Update(0.0f);
+	}
+}
+
+void FSlimeMaterialBlender::Apply(const UMaterialInterface* Material, const float Alpha)
+{
+	SetTarget(Material, Alpha, 0.0f);
+}
+
+bool FSlimeMaterialBlender::Update(const float DeltaTime)
+{
+	if (!Blending) return false;
+
+	Elapsed += DeltaTime;
+
+	const float BlendAlpha = Duration > 0.0f ? FMath::Clamp(Elapsed / Duration, 0.0f, 1.0f) : 1.0f;
+	Push(BlendAlpha);
+
+	if (BlendAlpha >= 1.0f)
+	{
+		Blending = false;
+	}
+	return Blending;
+}
+
+bool FSlimeMaterialBlender::IsBlending() const
+{
+	return Blending;
+}
+
+const FSlimeMaterialPose* FSlimeMaterialBlender::FindPose(const UMaterialInterface* Material) const
+{
+	return Poses.FindByPredicate([Material](const FSlimeMaterialPose& Pose) { return Pose.Material == Material; });
+}
+
+bool FSlimeMaterialBlender::BuildTarget(const UMaterialInterface* Material, const float Alpha, FSlimeMaterialPose& OutPose) const
+{
+	const FSlimeMaterialPose* Pose = FindPose(Material);
+	if (!Pose || Poses.Num() == 0) return false;
+
+	//Alpha blends from the base material towards the requested one
+	const FSlimeMaterialPose& Base = Poses[0];
+
+	OutPose.Material = Material;
+	OutPose.Scalars.SetNumUninitialized(Base.Scalars.Num());
+	OutPose.Vectors.SetNumUninitialized(Base.Vectors.Num());
+
+	for (int32 Index = 0; Index < Base.Scalars.Num(); ++Index)
+	{
+		OutPose.Scalars[Index] = FMath::Lerp(Base.Scalars[Index], Pose->Scalars[Index], Alpha);
+	}
+
+	for (int32 Index = 0; Index < Base.Vectors.Num(); ++Index)
+	{
+		OutPose.Vectors[Index] = FMath::Lerp(Base.Vectors[Index], Pose->Vectors[Index], Alpha);
+	}
+	return true;
+}
+
+void FSlimeMaterialBlender::Push(const float BlendAlpha)
+{
+	UMaterialInstanceDynamic* Material = DynamicMaterial.Get();
+	if (!Material) return;
+
+	for (int32 Index = 0; Index < ScalarIndices.Num(); ++Index)
+	{
+		const float Value = FMath::Lerp(Start.Scalars[Index], Target.Scalars[Index], BlendAlpha);
+		if (Value != Current.Scalars[Index])
+		{
+			Current.Scalars[Index] = Value;
+			Material->SetScalarParameterByIndex(ScalarIndices[Index], Value);
+		}
+	}
+
+	for (int32 Index = 0; Index < VectorIndices.Num(); ++Index)
+	{
+		const FLinearColor Value = FMath::Lerp(Start.Vectors[Index], Target.Vectors[Index], BlendAlpha);
+		if (Value != Current.Vectors[Index])
+		{
+			Current.Vectors[Index] = Value;
+			Material->SetVectorParameterByIndex(VectorIndices[Index], Value);
+		}
+	}
+}
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+
+// Values of the blended parameters for one source material
+struct FSlimeMaterialPose
+{
+	const UMaterialInterface* Material = nullptr;
+	TArray<float> Scalars;
+	TArray<FLinearColor> Vectors;
+};
+
+// Blends a dynamic material instance between a fixed set of materials. Only the parameters
+// that differ between them are blended, and they are written by cached parameter index
+struct FSlimeMaterialBlender
+{
+public:
+	// Resolves the differing parameters, the first material is the base that alphas blend from
+	void Initialize(UMaterialInstanceDynamic* InDynamicMaterial, const TArray<UMaterialInterface*>& Materials);
+
+	// Starts blending towards Material at Alpha over Duration seconds
+	void SetTarget(const UMaterialInterface* Material, const float Alpha, const float Duration);
+
+	// Jumps straight to Material at Alpha
+	void Apply(const UMaterialInterface* Material, const float Alpha);
+
+	// Advances the running blend, returns true while still blending
+	bool Update(const float DeltaTime);
+
+	bool IsBlending() const;
+
+private:
+	const FSlimeMaterialPose* FindPose(const UMaterialInterface* Material) const;
+
+	bool BuildTarget(const UMaterialInterface* Material, const float Alpha, FSlimeMaterialPose& OutPose) const;
+
+	void Push(const float BlendAlpha);
+
+private:
+	TWeakObjectPtr<UMaterialInstanceDynamic> DynamicMaterial;
+
+	TArray<FName> ScalarNames;
+	TArray<int32> ScalarIndices;
+	TArray<FName> VectorNames;
+	TArray<int32> VectorIndices;
+
+	TArray<FSlimeMaterialPose> Poses;
+
+	FSlimeMaterialPose Current;
+	FSlimeMaterialPose Start;
+	FSlimeMaterialPose Target;
+
+	const UMaterialInterface* TargetMaterial = nullptr;
+	float TargetAlpha = -1.0f;
+
+	float Elapsed = 0.0f;
+	float Duration = 0.0f;
+	bool Blending = false;
+};
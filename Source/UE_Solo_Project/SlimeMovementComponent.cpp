@@ -0,0 +1,428 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeMovementComponent.h"
+
+#include "SlimeCharacter.h"
+
+#include "Components/CapsuleComponent.h"
+
+namespace SlimeNetQuantize
+{
+	constexpr uint32 AxisMask = (1u << (GravityBits / 2)) - 1;
+
+	//An odd number of steps so zero lands on a step
+	constexpr float AxisSteps = static_cast<float>(AxisMask - 1) / 2.0f;
+
+	constexpr uint32 StateMask = 0x7;
+	constexpr uint32 HoldingBit = 0x8;
+	constexpr int32 ChargeShift = 4;
+
+	uint32 QuantizeAxis(const float Value)
+	{
+		return static_cast<uint32>(FMath::RoundToInt((FMath::Clamp(Value, -1.0f, 1.0f) + 1.0f) * AxisSteps));
+	}
+
+	float DequantizeAxis(const uint32 Value)
+	{
+		return static_cast<float>(Value & AxisMask) / AxisSteps - 1.0f;
+	}
+
+	uint32 PackGravity(const FVector& Direction)
+	{
+		const FVector3f Normal = FVector3f(Direction.GetSafeNormal(UE_SMALL_NUMBER, FVector(0.0f, 0.0f, -1.0f)));
+		const float L1Norm = FMath::Abs(Normal.X) + FMath::Abs(Normal.Y) + FMath::Abs(Normal.Z);
+
+		float X = Normal.X / L1Norm;
+		float Y = Normal.Y / L1Norm;
+
+		//Fold the lower hemisphere over the diagonals
+		if (Normal.Z < 0.0f)
+		{
+			const float FoldedX = (1.0f - FMath::Abs(Y)) * (X >= 0.0f ? 1.0f : -1.0f);
+			const float FoldedY = (1.0f - FMath::Abs(X)) * (Y >= 0.0f ? 1.0f : -1.0f);
+			X = FoldedX;
+			Y = FoldedY;
+		}
+
+		return QuantizeAxis(X) | (QuantizeAxis(Y) << (GravityBits / 2));
+	}
+
+	FVector UnpackGravity(const uint32 PackedGravity)
+	{
+		FVector3f Normal(DequantizeAxis(PackedGravity), DequantizeAxis(PackedGravity >> (GravityBits / 2)), 0.0f);
+		Normal.Z = 1.0f - FMath::Abs(Normal.X) - FMath::Abs(Normal.Y);
+
+		const float Fold = FMath::Max(-Normal.Z, 0.0f);
+		Normal.X += Normal.X >= 0.0f ? -Fold : Fold;
+		Normal.Y += Normal.Y >= 0.0f ? -Fold : Fold;
+
+		return FVector(Normal.GetSafeNormal());
+	}
+
+	uint16 PackMovementState(const int32 StateIndex, const bool Holding, const float Charge)
+	{
+		const uint32 QuantizedCharge = static_cast<uint32>(FMath::RoundToInt(FMath::Clamp(Charge, 0.0f, 1.0f) * 255.0f));
+
+		return static_cast<uint16>((StateIndex & StateMask) | (Holding ? HoldingBit : 0) | (QuantizedCharge << ChargeShift));
+	}
+
+	void UnpackMovementState(const uint16 PackedState, int32& OutStateIndex, bool& OutHolding, float& OutCharge)
+	{
+		OutStateIndex = PackedState & StateMask;
+		OutHolding = (PackedState & HoldingBit) != 0;
+		OutCharge = static_cast<float>((PackedState >> ChargeShift) & 0xFF) / 255.0f;
+	}
+}
+
+void FSlimeNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const FSavedMove_Slime& SlimeMove = static_cast<const FSavedMove_Slime&>(ClientMove);
+
+	PackedGravity = SlimeMove.SavedPackedGravity;
+	PackedState = SlimeMove.SavedPackedState;
+	HasLaunch = SlimeMove.SavedHasLaunch;
+	LaunchVelocity = SlimeMove.SavedLaunchVelocity;
+}
+
+bool FSlimeNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	//Most moves are on the ground, so default gravity only costs a bit
+	static const uint32 DefaultGravity = SlimeNetQuantize::PackGravity(FVector(0.0f, 0.0f, -1.0f));
+
+	bool IsDefaultGravity = PackedGravity == DefaultGravity;
+	Ar.SerializeBits(&IsDefaultGravity, 1);
+	if (IsDefaultGravity)
+	{
+		PackedGravity = DefaultGravity;
+	}
+	else
+	{
+		//Only the low bytes are read back
+		if (Ar.IsLoading())
+		{
+			PackedGravity = 0;
+		}
+		Ar.SerializeBits(&PackedGravity, SlimeNetQuantize::GravityBits);
+	}
+
+	if (Ar.IsLoading())
+	{
+		PackedState = 0;
+	}
+	Ar.SerializeBits(&PackedState, SlimeNetQuantize::MovementStateBits);
+
+	Ar.SerializeBits(&HasLaunch, 1);
+	if (HasLaunch)
+	{
+		bool Success = true;
+		LaunchVelocity.NetSerialize(Ar, PackageMap, Success);
+	}
+
+	return !Ar.IsError();
+}
+
+FSlimeNetworkMoveDataContainer::FSlimeNetworkMoveDataContainer()
+{
+	NewMoveData = &SlimeMoveData[0];
+	PendingMoveData = &SlimeMoveData[1];
+	OldMoveData = &SlimeMoveData[2];
+}
+
+void FSavedMove_Slime::Clear()
+{
+	Super::Clear();
+
+	SavedPackedGravity = 0;
+	SavedPackedState = 0;
+	SavedHasLaunch = false;
+	SavedLaunchVelocity = FVector::ZeroVector;
+}
+
+void FSavedMove_Slime::SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
+{
+	Super::SetMoveFor(Character, InDeltaTime, NewAccel, ClientData);
+
+	const UCharacterMovementComponent* Movement = Character->GetCharacterMovement();
+	SavedPackedGravity = SlimeNetQuantize::PackGravity(Movement->GetGravityDirection());
+
+	if (const ASlimeCharacter* Slime = Cast<ASlimeCharacter>(Character))
+	{
+		SavedPackedState = Slime->GetPackedMovementState();
+	}
+
+	//Launches are consumed by the move they were requested before
+	SavedHasLaunch = !Movement->PendingLaunchVelocity.IsZero();
+	SavedLaunchVelocity = Movement->PendingLaunchVelocity;
+}
+
+void FSavedMove_Slime::PrepMoveFor(ACharacter* Character)
+{
+	Super::PrepMoveFor(Character);
+
+	UCharacterMovementComponent* Movement = Character->GetCharacterMovement();
+	Movement->SetGravityDirection(SlimeNetQuantize::UnpackGravity(SavedPackedGravity));
+
+	if (SavedHasLaunch)
+	{
+		Movement->PendingLaunchVelocity = SavedLaunchVelocity;
+	}
+}
+
+bool FSavedMove_Slime::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+	const FSavedMove_Slime* NewSlimeMove = static_cast<const FSavedMove_Slime*>(NewMove.Get());
+
+	if (SavedHasLaunch || NewSlimeMove->SavedHasLaunch) return false;
+	if (SavedPackedGravity != NewSlimeMove->SavedPackedGravity) return false;
+	if (SavedPackedState != NewSlimeMove->SavedPackedState) return false;
+
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+FNetworkPredictionData_Client_Slime::FNetworkPredictionData_Client_Slime(const UCharacterMovementComponent& ClientMovement)
+	: Super(ClientMovement)
+{
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_Slime::AllocateNewMove()
+{
+	return FSavedMovePtr(new FSavedMove_Slime());
+}
+
+USlimeMovementComponent::USlimeMovementComponent()
+{
+	SetNetworkMoveDataContainer(SlimeMoveDataContainer);
+}
+
+FNetworkPredictionData_Client* USlimeMovementComponent::GetPredictionData_Client() const
+{
+	if (!ClientPredictionData)
+	{
+		USlimeMovementComponent* MutableThis = const_cast<USlimeMovementComponent*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_Slime(*this);
+	}
+
+	return ClientPredictionData;
+}
+
+void USlimeMovementComponent::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel)
+{
+	if (const FSlimeNetworkMoveData* MoveData = static_cast<const FSlimeNetworkMoveData*>(GetCurrentNetworkMoveData()))
+	{
+		ApplyClientMoveData(*MoveData, DeltaTime);
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+}
+
+void USlimeMovementComponent::ApplyClientMoveData(const FSlimeNetworkMoveData& MoveData, const float DeltaTime)
+{
+	//The owning client runs the state machine, the server simulates its moves with the same gravity
+	//as long as there is a surface to back it up, otherwise the client is corrected back
+	const FVector ClientGravity = SlimeNetQuantize::UnpackGravity(MoveData.PackedGravity);
+	const bool IsGravityVerified = VerifyClientGravity(ClientGravity, DeltaTime);
+	SetGravityDirection(IsGravityVerified ? ClientGravity : VerifiedGravity);
+
+	if (ASlimeCharacter* Slime = Cast<ASlimeCharacter>(CharacterOwner))
+	{
+		Slime->SetReplicatedMovementState(MoveData.PackedState);
+	}
+
+	//Climbing is entered and left by the client's state machine
+	TEnumAsByte<EMovementMode> ClientMovementMode;
+	TEnumAsByte<EMovementMode> ClientGroundMode;
+	uint8 ClientCustomMode;
+	UnpackNetworkMovementMode(MoveData.MovementMode, ClientMovementMode, ClientCustomMode, ClientGroundMode);
+
+	//Climbing needs a surface along the gravity it climbs with
+	const bool ClientIsClimbing = ClientMovementMode == MOVE_Custom && ClientCustomMode == static_cast<uint8>(ESlimeMovementMode::Climbing);
+	if (ClientIsClimbing != IsClimbing() && (!ClientIsClimbing || IsGravityVerified))
+	{
+		SetMovementMode(ClientMovementMode, ClientCustomMode);
+	}
+
+	if (MoveData.HasLaunch)
+	{
+		Launch(MoveData.LaunchVelocity.GetClampedToMaxSize(MaxClientLaunchSpeed));
+	}
+}
+
+bool USlimeMovementComponent::VerifyClientGravity(const FVector& ClientGravity, const float DeltaTime)
+{
+	//Unchanged apart from quantization
+	if ((ClientGravity | VerifiedGravity) > 0.999)
+	{
+		UnverifiedGravityTime = 0.0f;
+		return true;
+	}
+
+	//Detaching always returns to world gravity, any other direction has to lead to a surface
+	bool HasSurface = (ClientGravity | FVector::DownVector) > 0.999;
+	if (!HasSurface)
+	{
+		const FVector Start = UpdatedComponent->GetComponentLocation();
+		const float Reach = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + ClimbAdhesionDistance;
+
+		FHitResult Hit;
+		HasSurface = ClimbTrace(Start, Start + ClientGravity * Reach, Hit) && IsClimbableHit(Hit);
+	}
+
+	if (HasSurface)
+	{
+		VerifiedGravity = ClientGravity;
+		UnverifiedGravityTime = 0.0f;
+		return true;
+	}
+
+	//Transitions sweep gravity between two surfaces, so directions in between are allowed for a short time
+	UnverifiedGravityTime += DeltaTime;
+	return UnverifiedGravityTime <= MaxUnverifiedGravityTime;
+}
+
+float USlimeMovementComponent::GetMaxSpeed() const
+{
+	return IsClimbing() ? MaxClimbSpeed : Super::GetMaxSpeed();
+}
+
+bool USlimeMovementComponent::CanAttemptJump() const
+{
+	return Super::CanAttemptJump() || (IsJumpAllowed() && IsClimbing());
+}
+
+void USlimeMovementComponent::StartClimbing()
+{
+	SetMovementMode(MOVE_Custom, static_cast<uint8>(ESlimeMovementMode::Climbing));
+}
+
+void USlimeMovementComponent::StopClimbing()
+{
+	if (IsClimbing())
+	{
+		SetMovementMode(ClimbResult.IsOnFloor ? MOVE_Walking : MOVE_Falling);
+	}
+}
+
+bool USlimeMovementComponent::IsClimbing() const
+{
+	return MovementMode == MOVE_Custom && CustomMovementMode == static_cast<uint8>(ESlimeMovementMode::Climbing);
+}
+
+const FSlimeClimbResult& USlimeMovementComponent::GetClimbResult() const
+{
+	return ClimbResult;
+}
+
+void USlimeMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
+{
+	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+
+	ClimbResult = FSlimeClimbResult();
+
+	//Only move along the surface while climbing
+	if (IsClimbing())
+	{
+		Velocity = FVector::VectorPlaneProject(Velocity, GetGravityDirection());
+	}
+}
+
+void USlimeMovementComponent::PhysCustom(float DeltaTime, int32 Iterations)
+{
+	if (IsClimbing())
+	{
+		PhysClimbing(DeltaTime, Iterations);
+	}
+
+	Super::PhysCustom(DeltaTime, Iterations);
+}
+
+void USlimeMovementComponent::PhysClimbing(float DeltaTime, int32 Iterations)
+{
+	if (DeltaTime < MIN_TICK_TIME) return;
+
+	ClimbResult = FSlimeClimbResult();
+
+	const FVector GravityDirection = GetGravityDirection();
+
+	if (!HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+	{
+		CalcVelocity(DeltaTime, ClimbingFriction, false, BrakingDecelerationClimbing);
+	}
+	Velocity = FVector::VectorPlaneProject(Velocity, GravityDirection);
+
+	Iterations++;
+	bJustTeleported = false;
+
+	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+	const FVector Delta = Velocity * DeltaTime;
+
+	FHitResult Hit(1.0f);
+	SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
+
+	if (Hit.IsValidBlockingHit())
+	{
+		//Moved into another surface, the climbing state decides whether to climb onto it
+		if (IsClimbableHit(Hit) && !Hit.Normal.Equals(-GravityDirection))
+		{
+			ClimbResult.HasNewSurface = true;
+			ClimbResult.NewSurfaceHit = Hit;
+		}
+
+		HandleImpact(Hit, DeltaTime, Delta);
+		SlideAlongSurface(Delta, 1.0f - Hit.Time, Hit.Normal, Hit, true);
+	}
+
+	UpdateClimbSurface();
+
+	if (!bJustTeleported && !HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+	{
+		Velocity = FVector::VectorPlaneProject((UpdatedComponent->GetComponentLocation() - OldLocation) / DeltaTime, GravityDirection);
+	}
+}
+
+void USlimeMovementComponent::UpdateClimbSurface()
+{
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const FVector GravityDirection = GetGravityDirection();
+
+	FHitResult SurfaceHit;
+	if (ClimbTrace(Location, Location + GravityDirection * ClimbAdhesionDistance, SurfaceHit))
+	{
+		ClimbResult.HasSurface = true;
+		ClimbResult.SurfaceHit = SurfaceHit;
+		ClimbResult.IsOnFloor = GravityDirection.Equals(FVector(0.0f, 0.0f, -1.0f));
+
+		//Keep the capsule held against the surface
+		const float Gap = SurfaceHit.Distance - CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		if (Gap > UE_KINDA_SMALL_NUMBER)
+		{
+			FHitResult AdhesionHit;
+			SafeMoveUpdatedComponent(GravityDirection * Gap, UpdatedComponent->GetComponentQuat(), true, AdhesionHit);
+		}
+		return;
+	}
+
+	//Look back underneath the ledge the slime has moved off
+	const FVector WrapAroundStart = Location + GravityDirection * WrapAroundDepth;
+	const FVector WrapAroundEnd = WrapAroundStart - UpdatedComponent->GetForwardVector() * WrapAroundReach;
+
+	ClimbResult.HasWrapAround = ClimbTrace(WrapAroundStart, WrapAroundEnd, ClimbResult.WrapAroundHit);
+}
+
+bool USlimeMovementComponent::IsClimbableHit(const FHitResult& Hit) const
+{
+	const UPrimitiveComponent* Component = Hit.GetComponent();
+	return Component && Component->GetCollisionResponseToChannel(ECC_GameTraceChannel1) == ECR_Block;
+}
+
+bool USlimeMovementComponent::ClimbTrace(const FVector& Start, const FVector& End, FHitResult& OutHit) const
+{
+	SLIME_MOVEMENT_COUNT(TracesIssued, 1);
+
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SlimeClimbSurface), false, CharacterOwner);
+
+	return GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECC_GameTraceChannel1, QueryParams);
+}
@@ -0,0 +1,203 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+#include "SlimeMovementComponent.generated.h"
+
+class ASlimeCharacter;
+
+UENUM(BlueprintType)
+enum class ESlimeMovementMode : uint8
+{
+	None UMETA(Hidden),
+	Climbing
+};
+
+// What the climbing movement found during its last update
+struct FSlimeClimbResult
+{
+	//Surface the slime is held against
+	bool HasSurface = false;
+	FHitResult SurfaceHit;
+
+	//Surface the slime moved into
+	bool HasNewSurface = false;
+	FHitResult NewSurfaceHit;
+
+	//Surface underneath the ledge the slime moved off
+	bool HasWrapAround = false;
+	FHitResult WrapAroundHit;
+
+	//Held against a surface with default gravity
+	bool IsOnFloor = false;
+};
+
+// Speed range a held jump or throw charges through, launches scale these along up and forward
+namespace SlimeCharge
+{
+	constexpr double MinJumpVelocity = 1000.0;
+	constexpr double MaxJumpVelocity = 1300.0;
+	constexpr double MinThrowVelocity = 600.0;
+	constexpr double MaxThrowVelocity = 800.0;
+
+	// Largest speed a launch charged up to MaxVelocity reaches along up and forward, plus network quantization error
+	constexpr double GetMaxLaunchSpeed(const double MaxVelocity)
+	{
+		return MaxVelocity * UE_DOUBLE_SQRT_2 + 1.0;
+	}
+}
+
+// Compact network encodings for the slime's movement state
+namespace SlimeNetQuantize
+{
+	// Gravity as an octahedral encoded normal, 12 bits per axis. Zero and the poles are exact
+	constexpr int32 GravityBits = 24;
+
+	uint32 PackGravity(const FVector& Direction);
+
+	FVector UnpackGravity(const uint32 PackedGravity);
+
+	// State index, holding flag and jump charge
+	constexpr int32 MovementStateBits = 12;
+
+	uint16 PackMovementState(const int32 StateIndex, const bool Holding, const float Charge);
+
+	void UnpackMovementState(const uint16 PackedState, int32& OutStateIndex, bool& OutHolding, float& OutCharge);
+}
+
+// Gravity, state and launch the client predicted for a move
+struct FSlimeNetworkMoveData : public FCharacterNetworkMoveData
+{
+	typedef FCharacterNetworkMoveData Super;
+
+	uint32 PackedGravity = 0;
+	uint16 PackedState = 0;
+	bool HasLaunch = false;
+	FVector_NetQuantize10 LaunchVelocity;
+
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+};
+
+struct FSlimeNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+{
+	FSlimeNetworkMoveDataContainer();
+
+private:
+	FSlimeNetworkMoveData SlimeMoveData[3];
+};
+
+// Saved move that also restores gravity and launches when the client replays after a correction
+class FSavedMove_Slime : public FSavedMove_Character
+{
+public:
+	typedef FSavedMove_Character Super;
+
+	uint32 SavedPackedGravity = 0;
+	uint16 SavedPackedState = 0;
+	bool SavedHasLaunch = false;
+	FVector SavedLaunchVelocity = FVector::ZeroVector;
+
+	virtual void Clear() override;
+
+	virtual void SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override;
+
+	virtual void PrepMoveFor(ACharacter* Character) override;
+
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+};
+
+class FNetworkPredictionData_Client_Slime : public FNetworkPredictionData_Client_Character
+{
+public:
+	typedef FNetworkPredictionData_Client_Character Super;
+
+	FNetworkPredictionData_Client_Slime(const UCharacterMovementComponent& ClientMovement);
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
+
+// Character movement that sends the slime's gravity, state and launches with each client move,
+// and climbs surfaces in a custom movement mode that keeps the slime held against them
+UCLASS()
+class UE_SOLO_PROJECT_API USlimeMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Largest launch a client move may request, a fully charged jump plus quantization error
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Character Movement: Networking")
+	float MaxClientLaunchSpeed = SlimeCharge::GetMaxLaunchSpeed(SlimeCharge::MaxJumpVelocity);
+
+	// How long a client may hold a gravity with no surface along it, long enough for a gravity transition to finish
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Character Movement: Networking")
+	float MaxUnverifiedGravityTime = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Character Movement: Climbing")
+	float MaxClimbSpeed = 500.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Character Movement: Climbing")
+	float ClimbingFriction = 8.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Character Movement: Climbing")
+	float BrakingDecelerationClimbing = 2000.0f;
+
+	// How far along gravity the surface is looked for
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Character Movement: Climbing")
+	float ClimbAdhesionDistance = 100.0f;
+
+	// How far past a ledge the wrap around surface is looked for
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Character Movement: Climbing")
+	float WrapAroundDepth = 200.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Character Movement: Climbing")
+	float WrapAroundReach = 30.0f;
+
+	USlimeMovementComponent();
+
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+
+	virtual float GetMaxSpeed() const override;
+
+	virtual bool CanAttemptJump() const override;
+
+	void StartClimbing();
+
+	void StopClimbing();
+
+	bool IsClimbing() const;
+
+	const FSlimeClimbResult& GetClimbResult() const;
+
+protected:
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+
+	virtual void PhysCustom(float DeltaTime, int32 Iterations) override;
+
+	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
+
+private:
+	FSlimeNetworkMoveDataContainer SlimeMoveDataContainer;
+
+	FSlimeClimbResult ClimbResult;
+
+	//Last client gravity the server found a surface behind, and how long the client has been away from it
+	FVector VerifiedGravity = FVector::DownVector;
+	float UnverifiedGravityTime = 0.0f;
+
+	void ApplyClientMoveData(const FSlimeNetworkMoveData& MoveData, const float DeltaTime);
+
+	bool VerifyClientGravity(const FVector& ClientGravity, const float DeltaTime);
+
+	void PhysClimbing(float DeltaTime, int32 Iterations);
+
+	void UpdateClimbSurface();
+
+	bool IsClimbableHit(const FHitResult& Hit) const;
+
+	bool ClimbTrace(const FVector& Start, const FVector& End, FHitResult& OutHit) const;
+};
@@ -0,0 +1,17 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeMovementStats.h"
+
+DEFINE_STAT(STAT_SlimeStateUpdate);
+DEFINE_STAT(STAT_SlimeStateHit);
+DEFINE_STAT(STAT_SlimeLineTrace);
+DEFINE_STAT(STAT_SlimeSetState);
+DEFINE_STAT(STAT_SlimeBuildBindings);
+DEFINE_STAT(STAT_SlimeSurfacePathQuery);
+DEFINE_STAT(STAT_SlimeSurfaceGraphRebuild);
+
+DEFINE_STAT(STAT_SlimeTracesIssued);
+DEFINE_STAT(STAT_SlimeTransitions);
+DEFINE_STAT(STAT_SlimeGravityTransitions);
+
+CSV_DEFINE_CATEGORY_MODULE(UE_SOLO_PROJECT_API, SlimeMovement, true);
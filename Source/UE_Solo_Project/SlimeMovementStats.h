@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("SlimeMovement"), STATGROUP_SlimeMovement, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("State Decide"), STAT_SlimeStateUpdate, STATGROUP_SlimeMovement, UE_SOLO_PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("State OnHit"), STAT_SlimeStateHit, STATGROUP_SlimeMovement, UE_SOLO_PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Line Trace"), STAT_SlimeLineTrace, STATGROUP_SlimeMovement, UE_SOLO_PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Set State"), STAT_SlimeSetState, STATGROUP_SlimeMovement, UE_SOLO_PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Bindings"), STAT_SlimeBuildBindings, STATGROUP_SlimeMovement, UE_SOLO_PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Surface Path Query"), STAT_SlimeSurfacePathQuery, STATGROUP_SlimeMovement, UE_SOLO_PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Surface Graph Rebuild"), STAT_SlimeSurfaceGraphRebuild, STATGROUP_SlimeMovement, UE_SOLO_PROJECT_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces Issued"), STAT_SlimeTracesIssued, STATGROUP_SlimeMovement, UE_SOLO_PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Transitions"), STAT_SlimeTransitions, STATGROUP_SlimeMovement, UE_SOLO_PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Gravity Transitions"), STAT_SlimeGravityTransitions, STATGROUP_SlimeMovement, UE_SOLO_PROJECT_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(UE_SOLO_PROJECT_API, SlimeMovement);
+
+//Times a scope for both stat SlimeMovement and the CSV profiler
+#define SLIME_MOVEMENT_SCOPE(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_Slime##Name); \
+	CSV_SCOPED_TIMING_STAT(SlimeMovement, Name)
+
+//Adds to a per frame counter for both stat SlimeMovement and the CSV profiler
+#define SLIME_MOVEMENT_COUNT(Name, Amount) \
+	INC_DWORD_STAT_BY(STAT_Slime##Name, Amount); \
+	CSV_CUSTOM_STAT(SlimeMovement, Name, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate)
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeSpringArmComponent.h"
+
+#include "SlimeCharacter.h"
+
+#include "Engine/World.h"
+
+USlimeSpringArmComponent::USlimeSpringArmComponent()
+{
+	bDoCollisionTest = false;
+}
+
+void USlimeSpringArmComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	GravityRotation = GetGravityToWorld();
+	CollisionSweepDelegate.BindUObject(this, &USlimeSpringArmComponent::OnCollisionSweepCompleted);
+}
+
+void USlimeSpringArmComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	//Gravity transitions already blend the direction, this smooths the arm over whatever is left
+	GravityRotation = FMath::QInterpTo(GravityRotation, GetGravityToWorld(), DeltaTime, GravityRotationSpeed);
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+FRotator USlimeSpringArmComponent::GetTargetRotation() const
+{
+	return (GravityRotation * Super::GetTargetRotation().Quaternion()).Rotator();
+}
+
+void USlimeSpringArmComponent::UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime)
+{
+	//Places the arm at full length, collision is applied below
+	Super::UpdateDesiredArmLocation(false, bDoLocationLag, bDoRotationLag, DeltaTime);
+
+	if (!UseAsyncCollisionTest || TargetArmLength == 0.0f) return;
+
+	const FVector Origin = PreviousArmOrigin;
+	const FVector Desired = ClampToProbedSurfaces(Origin, UnfixedCameraPosition);
+
+	//Result arrives before next frame's update
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SlimeSpringArm), false, GetOwner());
+	GetWorld()->AsyncSweepByChannel(
+		EAsyncTraceType::Single,
+		Origin,
+		Desired,
+		FQuat::Identity,
+		ProbeChannel,
+		FCollisionShape::MakeSphere(ProbeSize),
+		QueryParams,
+		FCollisionResponseParams::DefaultResponseParam,
+		&CollisionSweepDelegate
+	);
+
+	ArmFraction = BlockedArmFraction < ArmFraction ? BlockedArmFraction : FMath::FInterpTo(ArmFraction, BlockedArmFraction, DeltaTime, ArmRecoverySpeed);
+
+	const FVector ResultLocation = Origin + (Desired - Origin) * ArmFraction;
+	bIsCameraFixed = !ResultLocation.Equals(UnfixedCameraPosition);
+
+	const FTransform WorldCameraTransform(GetComponentQuat() * RelativeSocketRotation, ResultLocation);
+	RelativeSocketLocation = WorldCameraTransform.GetRelativeTransform(GetComponentTransform()).GetLocation();
+
+	UpdateChildTransforms();
+}
+
+FQuat USlimeSpringArmComponent::GetGravityToWorld() const
+{
+	const ASlimeCharacter* Slime = Cast<ASlimeCharacter>(GetOwner());
+	if (!Slime) return FQuat::Identity;
+
+	return Slime->GetCharacterMovement()->GetGravityToWorldTransform();
+}
+
+FVector USlimeSpringArmComponent::ClampToProbedSurfaces(const FVector& Origin, const FVector& Desired) const
+{
+	const ASlimeCharacter* Slime = Cast<ASlimeCharacter>(GetOwner());
+	if (!Slime) return Desired;
+
+	FVector Result = Desired;
+
+	//Keeps the camera a probe radius in front of a plane the slime is known to be facing
+	const auto ClampToPlane = [this, &Origin, &Result](const FHitResult& Hit)
+	{
+		const double OriginHeight = (Origin - Hit.ImpactPoint) | Hit.ImpactNormal;
+		const double ResultHeight = (Result - Hit.ImpactPoint) | Hit.ImpactNormal;
+		if (OriginHeight <= ProbeSize || ResultHeight >= ProbeSize) return;
+
+		Result = Origin + (Result - Origin) * ((OriginHeight - ProbeSize) / (OriginHeight - ResultHeight));
+	};
+
+	//Reuse what the state machine and climbing found this frame or last instead of querying again, the sweep covers the rest
+	FHitResult Hit;
+	if (Slime->FindProbeResult(ESurfaceProbe::Down, Hit))
+	{
+		ClampToPlane(Hit);
+	}
+	if (Slime->FindProbeResult(ESurfaceProbe::Up, Hit))
+	{
+		ClampToPlane(Hit);
+	}
+
+	const USlimeMovementComponent* SlimeMovement = Slime->GetSlimeMovement();
+	if (SlimeMovement && SlimeMovement->IsClimbing() && SlimeMovement->GetClimbResult().HasSurface)
+	{
+		ClampToPlane(SlimeMovement->GetClimbResult().SurfaceHit);
+	}
+
+	return Result;
+}
+
+void USlimeSpringArmComponent::OnCollisionSweepCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceData)
+{
+	BlockedArmFraction = 1.0f;
+
+	for (const FHitResult& Hit : TraceData.OutHits)
+	{
+		if (Hit.bBlockingHit)
+		{
+			BlockedArmFraction = Hit.Time;
+			break;
+		}
+	}
+}
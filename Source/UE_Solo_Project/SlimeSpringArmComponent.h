@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "WorldCollision.h"
+
+#include "SlimeSpringArmComponent.generated.h"
+
+class ASlimeCharacter;
+
+// Camera boom that turns with the slime's gravity and never blocks the game thread on a
+// scene query. The arm is clamped against surfaces the slime already probed, and the rest
+// of the collision comes from an async sweep that shortens the arm a frame later
+UCLASS(ClassGroup = Camera, meta = (BlueprintSpawnableComponent))
+class UE_SOLO_PROJECT_API USlimeSpringArmComponent : public USpringArmComponent
+{
+	GENERATED_BODY()
+
+public:
+	// How quickly the arm turns to follow a change of gravity, 0 follows it instantly
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gravity")
+	float GravityRotationSpeed = 6.0f;
+
+	// Replaces bDoCollisionTest, which would sweep synchronously
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = CameraCollision)
+	bool UseAsyncCollisionTest = true;
+
+	// How quickly the arm grows back out once nothing blocks it, it always pulls in straight away
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = CameraCollision)
+	float ArmRecoverySpeed = 8.0f;
+
+private:
+	//Gravity to world rotation the arm is currently using
+	FQuat GravityRotation = FQuat::Identity;
+
+	FTraceDelegate CollisionSweepDelegate;
+
+	//Unblocked fraction of the arm from the latest sweep, and the smoothed fraction in use
+	float BlockedArmFraction = 1.0f;
+	float ArmFraction = 1.0f;
+
+public:
+	USlimeSpringArmComponent();
+
+	virtual void BeginPlay() override;
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// Control rotation is taken as relative to the slime's gravity
+	virtual FRotator GetTargetRotation() const override;
+
+protected:
+	virtual void UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime) override;
+
+private:
+	FQuat GetGravityToWorld() const;
+
+	FVector ClampToProbedSurfaces(const FVector& Origin, const FVector& Desired) const;
+
+	void OnCollisionSweepCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceData);
+};
@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeStateMachineSubsystem.h"
+
+#include "SlimeCharacter.h"
+
+#include "Async/ParallelFor.h"
+
+void USlimeStateMachineSubsystem::Register(ASlimeCharacter* Slime)
+{
+	if (!Slime) return;
+
+	Slimes.AddUnique(Slime);
+}
+
+void USlimeStateMachineSubsystem::Unregister(ASlimeCharacter* Slime)
+{
+	Slimes.RemoveSwap(Slime);
+}
+
+void USlimeStateMachineSubsystem::Tick(float DeltaTime)
+{
+	UpdatingSlimes.Reset();
+
+	for (int32 Index = Slimes.Num() - 1; Index >= 0; --Index)
+	{
+		ASlimeCharacter* Slime = Slimes[Index].Get();
+		if (!Slime)
+		{
+			Slimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		if (Slime->UseParallelStateUpdate && Slime->ShouldRunStateMachine() && Slime->PrepareStateUpdate(DeltaTime))
+		{
+			UpdatingSlimes.Add(Slime);
+		}
+	}
+
+	Decisions.SetNum(UpdatingSlimes.Num(), EAllowShrinking::No);
+
+	//Probe and decide, each slime is only touched by one worker
+	ParallelFor(UpdatingSlimes.Num(), [this](const int32 Index)
+	{
+		Decisions[Index] = UpdatingSlimes[Index]->DecideState();
+	});
+
+	//Transitions move actors and start transitions, so they stay on the game thread
+	for (int32 Index = 0; Index < UpdatingSlimes.Num(); ++Index)
+	{
+		UpdatingSlimes[Index]->CommitState(Decisions[Index]);
+	}
+}
+
+TStatId USlimeStateMachineSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USlimeStateMachineSubsystem, STATGROUP_Tickables);
+}
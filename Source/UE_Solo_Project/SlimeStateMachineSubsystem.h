@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "PlayerState/PlayerStateInterface.h"
+
+#include "SlimeStateMachineSubsystem.generated.h"
+
+class ASlimeCharacter;
+
+// Updates every registered slime's state in two phases. States decide in parallel, only
+// reading the world and probing, then commit their transitions on the game thread
+UCLASS()
+class UE_SOLO_PROJECT_API USlimeStateMachineSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	TArray<TWeakObjectPtr<ASlimeCharacter>> Slimes;
+
+	//Slimes updating this frame and what they decided
+	TArray<ASlimeCharacter*> UpdatingSlimes;
+	TArray<FStateDecision> Decisions;
+
+public:
+	void Register(ASlimeCharacter* Slime);
+
+	void Unregister(ASlimeCharacter* Slime);
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+};
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Surface rules shared by ASlimeCharacter and the slime crowd processors
+struct FSlimeSurfaceMath
+{
+	// Movement axes for walking on a surface with the given normal
+	static void GetMovementAxes(const FVector& SurfaceNormal, FVector& OutAxisX, FVector& OutAxisY)
+	{
+		//Recalculate right vector
+		const FVector RightVector = FVector::CrossProduct(FVector::UpVector, SurfaceNormal);
+		//Recalculate forward vector
+		const FVector ForwardVector = FVector::CrossProduct(SurfaceNormal, RightVector);
+
+		OutAxisX = RightVector * -1.0f;
+		OutAxisY = ForwardVector;
+	}
+
+	// Location to move to when wrapping around onto the surface that was hit
+	static FVector GetWrapAroundLocation(const FHitResult& HitResult)
+	{
+		return HitResult.ImpactPoint + HitResult.Normal * 90.0f;
+	}
+};
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeTrajectory.h"
+
+#include "Engine/World.h"
+
+#include "SlimeSurfaceMath.h"
+
+bool FSlimeTrajectory::PredictLanding(
+	const UWorld* World,
+	const FVector& Start,
+	const FVector& Velocity,
+	const FVector& Gravity,
+	const FCollisionQueryParams& QueryParams,
+	FSlimeLandingPrediction& OutPrediction,
+	TArray<FVector>* OutPath,
+	const float MaxTime,
+	const float SubStep)
+{
+	OutPrediction = FSlimeLandingPrediction();
+
+	if (!World || SubStep <= 0.0f) return false;
+
+	if (OutPath)
+	{
+		OutPath->Reset();
+		OutPath->Add(Start);
+	}
+
+	FVector SegmentStart = Start;
+
+	for (float Time = SubStep; Time <= MaxTime; Time += SubStep)
+	{
+		//Closed form position, so step size does not accumulate error
+		const FVector SegmentEnd = Start + Velocity * Time + 0.5f * Gravity * Time * Time;
+
+		FHitResult HitResult;
+		if (World->LineTraceSingleByChannel(HitResult, SegmentStart, SegmentEnd, ECC_GameTraceChannel1, QueryParams))
+		{
+			OutPrediction.IsValid = true;
+			OutPrediction.Location = HitResult.Location;
+			OutPrediction.Normal = HitResult.Normal;
+			OutPrediction.NewGravity = HitResult.Normal * -1.0f;
+			OutPrediction.TimeToLand = Time - SubStep + SubStep * HitResult.Time;
+			FSlimeSurfaceMath::GetMovementAxes(HitResult.Normal, OutPrediction.MovementVectorX, OutPrediction.MovementVectorY);
+
+			if (OutPath)
+			{
+				OutPath->Add(HitResult.Location);
+			}
+			return true;
+		}
+
+		if (OutPath)
+		{
+			OutPath->Add(SegmentEnd);
+		}
+		SegmentStart = SegmentEnd;
+	}
+
+	return false;
+}
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+
+class UWorld;
+
+// Where a jump is expected to come down and how the slime should stick to it
+struct FSlimeLandingPrediction
+{
+	bool IsValid = false;
+	FVector Location = FVector::ZeroVector;
+	FVector Normal = FVector::ZeroVector;
+	FVector NewGravity = FVector::ZeroVector;
+	FVector MovementVectorX = FVector::ZeroVector;
+	FVector MovementVectorY = FVector::ZeroVector;
+	float TimeToLand = 0.0f;
+};
+
+// Ballistic arc solver for slime jumps
+struct FSlimeTrajectory
+{
+	// Sub-steps the arc under Gravity and traces it against climbable surfaces, stopping at the first hit.
+	// OutPath, when given, receives the points of the arc up to the landing point
+	static bool PredictLanding(
+		const UWorld* World,
+		const FVector& Start,
+		const FVector& Velocity,
+		const FVector& Gravity,
+		const FCollisionQueryParams& QueryParams,
+		FSlimeLandingPrediction& OutPrediction,
+		TArray<FVector>* OutPath = nullptr,
+		const float MaxTime = 3.0f,
+		const float SubStep = 1.0f / 30.0f);
+};
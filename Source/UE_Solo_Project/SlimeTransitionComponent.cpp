@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeTransitionComponent.h"
+
+#include "GameFramework/CharacterMovementComponent.h"
+
+#include "SlimeCharacter.h"
+
+USlimeTransitionComponent::USlimeTransitionComponent()
+{
+	//Only ticks while a transition is running
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void USlimeTransitionComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (GravityTransition.IsActive)
+	{
+		ApplyGravity(AdvanceTransition(GravityTransition, GravityCurve, DeltaTime));
+	}
+
+	if (LocationTransition.IsActive)
+	{
+		ApplyLocation(AdvanceTransition(LocationTransition, LocationCurve, DeltaTime));
+	}
+
+	UpdateTransitioning();
+}
+
+void USlimeTransitionComponent::StartGravityTransition(const FVector& NewGravityDirection, const float PlaybackRate)
+{
+	const ACharacter* Character = Cast<ACharacter>(GetOwner());
+	if (!Character) return;
+
+	StartTransition(GravityTransition, Character->GetCharacterMovement()->GetGravityDirection(), NewGravityDirection.GetSafeNormal(), GravityDuration, PlaybackRate);
+}
+
+void USlimeTransitionComponent::StartLocationTransition(const FVector& NewLocation, const float PlaybackRate)
+{
+	if (!GetOwner()) return;
+
+	StartTransition(LocationTransition, GetOwner()->GetActorLocation(), NewLocation, LocationDuration, PlaybackRate);
+}
+
+bool USlimeTransitionComponent::IsTransitioning() const
+{
+	return GravityTransition.IsActive || LocationTransition.IsActive;
+}
+
+void USlimeTransitionComponent::StartTransition(FSlimeTransition& Transition, const FVector& Start, const FVector& Target, const float Duration, const float PlaybackRate)
+{
+	if (Transition.IsActive && Transition.Target.Equals(Target)) return;
+
+	Transition.Start = Start;
+	Transition.Target = Target;
+	Transition.Elapsed = 0.0f;
+	//Zero length transitions snap to the target on the next tick
+	Transition.Duration = PlaybackRate > 0.0f ? FMath::Max(Duration / PlaybackRate, 0.0f) : 0.0f;
+	Transition.IsActive = true;
+
+	SetComponentTickEnabled(true);
+	UpdateTransitioning();
+}
+
+float USlimeTransitionComponent::AdvanceTransition(FSlimeTransition& Transition, const UCurveFloat* Curve, const float DeltaTime) const
+{
+	Transition.Elapsed += DeltaTime;
+
+	const float Time = Transition.Duration > 0.0f ? FMath::Clamp(Transition.Elapsed / Transition.Duration, 0.0f, 1.0f) : 1.0f;
+	if (Time >= 1.0f)
+	{
+		Transition.IsActive = false;
+		return 1.0f;
+	}
+
+	return Curve ? Curve->GetFloatValue(Time) : Time;
+}
+
+void USlimeTransitionComponent::ApplyGravity(const float Alpha) const
+{
+	ACharacter* Character = Cast<ACharacter>(GetOwner());
+	if (!Character) return;
+
+	//Rotate between the directions so opposite gravities never pass through zero
+	const FQuat Rotation = FQuat::Slerp(FQuat::Identity, FQuat::FindBetweenNormals(GravityTransition.Start, GravityTransition.Target), Alpha);
+
+	Character->GetCharacterMovement()->SetGravityDirection(Rotation.RotateVector(GravityTransition.Start));
+}
+
+void USlimeTransitionComponent::ApplyLocation(const float Alpha) const
+{
+	if (!GetOwner()) return;
+
+	GetOwner()->SetActorLocation(FMath::Lerp(LocationTransition.Start, LocationTransition.Target, Alpha), SweepLocation);
+}
+
+void USlimeTransitionComponent::UpdateTransitioning()
+{
+	const bool Transitioning = IsTransitioning();
+
+	if (ASlimeCharacter* Slime = Cast<ASlimeCharacter>(GetOwner()))
+	{
+		Slime->IsTransitioning = Transitioning;
+	}
+
+	if (!Transitioning)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Curves/CurveFloat.h"
+
+#include "SlimeTransitionComponent.generated.h"
+
+// A value blended from where it was when the transition started
+struct FSlimeTransition
+{
+	FVector Start = FVector::ZeroVector;
+	FVector Target = FVector::ZeroVector;
+	float Elapsed = 0.0f;
+	float Duration = 0.0f;
+	bool IsActive = false;
+};
+
+// Blends the owning slime's gravity direction and location over time, replacing the Blueprint timelines
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class UE_SOLO_PROJECT_API USlimeTransitionComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Alpha over normalised time, linear when unset
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Transition")
+	UCurveFloat* GravityCurve;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Transition")
+	UCurveFloat* LocationCurve;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Transition")
+	float GravityDuration = 0.3f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Transition")
+	float LocationDuration = 0.2f;
+
+	// Sweep the capsule while moving to the new location
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Transition")
+	bool SweepLocation = false;
+
+private:
+	FSlimeTransition GravityTransition;
+	FSlimeTransition LocationTransition;
+
+public:
+	USlimeTransitionComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// Starting a transition towards a new target while one is running restarts it from the current value,
+	// asking again for the target already being blended to keeps the running transition
+	void StartGravityTransition(const FVector& NewGravityDirection, const float PlaybackRate = 1.0f);
+
+	void StartLocationTransition(const FVector& NewLocation, const float PlaybackRate = 1.0f);
+
+	UFUNCTION(BlueprintCallable)
+	bool IsTransitioning() const;
+
+private:
+	void StartTransition(FSlimeTransition& Transition, const FVector& Start, const FVector& Target, const float Duration, const float PlaybackRate);
+
+	float AdvanceTransition(FSlimeTransition& Transition, const UCurveFloat* Curve, const float DeltaTime) const;
+
+	void ApplyGravity(const float Alpha) const;
+
+	void ApplyLocation(const float Alpha) const;
+
+	void UpdateTransitioning();
+};
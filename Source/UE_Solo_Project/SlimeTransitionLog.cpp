@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeTransitionLog.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Trace/Trace.inl"
+
+static_assert(FMath::IsPowerOfTwo(FSlimeTransitionLog::Capacity), "Capacity must be a power of two");
+
+UE_TRACE_CHANNEL_DEFINE(SlimeTransitionChannel)
+
+UE_TRACE_EVENT_BEGIN(SlimeMovement, StateTransition)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, Frame)
+	UE_TRACE_EVENT_FIELD(uint32, ActorId)
+	UE_TRACE_EVENT_FIELD(uint8, FromState)
+	UE_TRACE_EVENT_FIELD(uint8, ToState)
+	UE_TRACE_EVENT_FIELD(uint8, Reason)
+	UE_TRACE_EVENT_FIELD(float, PositionX)
+	UE_TRACE_EVENT_FIELD(float, PositionY)
+	UE_TRACE_EVENT_FIELD(float, PositionZ)
+UE_TRACE_EVENT_END()
+
+FSlimeTransitionLog::FSlot FSlimeTransitionLog::Slots[FSlimeTransitionLog::Capacity];
+std::atomic<uint64> FSlimeTransitionLog::WriteIndex{ 0 };
+
+void FSlimeTransitionLog::Record(const FSlimeTransitionRecord& Record)
+{
+	const uint64 Index = WriteIndex.fetch_add(1, std::memory_order_relaxed);
+	FSlot& Slot = Slots[Index & (Capacity - 1)];
+
+	//Readers skip the slot until the record is complete
+	Slot.Sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	Slot.Record = Record;
+	Slot.Sequence.store(Index + 1, std::memory_order_release);
+
+	UE_TRACE_LOG(SlimeMovement, StateTransition, SlimeTransitionChannel)
+		<< StateTransition.Cycle(FPlatformTime::Cycles64())
+		<< StateTransition.Frame(Record.Frame)
+		<< StateTransition.ActorId(Record.ActorId)
+		<< StateTransition.FromState(Record.FromState)
+		<< StateTransition.ToState(Record.ToState)
+		<< StateTransition.Reason(static_cast<uint8>(Record.Reason))
+		<< StateTransition.PositionX(Record.Position.X)
+		<< StateTransition.PositionY(Record.Position.Y)
+		<< StateTransition.PositionZ(Record.Position.Z);
+}
+
+void FSlimeTransitionLog::Snapshot(TArray<FSlimeTransitionRecord>& OutRecords)
+{
+	OutRecords.Reset();
+
+	const uint64 End = WriteIndex.load(std::memory_order_acquire);
+	const uint64 Begin = End > Capacity ? End - Capacity : 0;
+
+	for (uint64 Index = Begin; Index < End; ++Index)
+	{
+		const FSlot& Slot = Slots[Index & (Capacity - 1)];
+
+		if (Slot.Sequence.load(std::memory_order_acquire) != Index + 1) continue;
+		const FSlimeTransitionRecord Record = Slot.Record;
+
+		//Overwritten while copying
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (Slot.Sequence.load(std::memory_order_relaxed) != Index + 1) continue;
+
+		OutRecords.Add(Record);
+	}
+}
+
+static FAutoConsoleCommand DumpSlimeTransitionsCommand(
+	TEXT("Slime.DumpTransitions"),
+	TEXT("Prints the recent slime state transitions"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		TArray<FSlimeTransitionRecord> Records;
+		FSlimeTransitionLog::Snapshot(Records);
+
+		for (const FSlimeTransitionRecord& Record : Records)
+		{
+			UE_LOG(LogTemp, Display, TEXT("Frame %llu Actor %u : %u -> %u Reason %u at %s"),
+				Record.Frame, Record.ActorId, Record.FromState, Record.ToState, static_cast<uint32>(Record.Reason), *Record.Position.ToString());
+		}
+	}));
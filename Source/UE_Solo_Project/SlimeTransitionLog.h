@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+
+UE_TRACE_CHANNEL_EXTERN(SlimeTransitionChannel, UE_SOLO_PROJECT_API)
+
+// Why a slime changed state
+enum class ESlimeTransitionReason : uint8
+{
+	Initial,
+	Input,
+	Landed,
+	Grounded,
+	FoundSurface,
+	WrapAround,
+	LostSurface,
+	Other
+};
+
+// A compact record of one state transition
+struct FSlimeTransitionRecord
+{
+	uint64 Frame = 0;
+	FVector3f Position = FVector3f::ZeroVector;
+	uint32 ActorId = 0;
+	uint8 FromState = 0;
+	uint8 ToState = 0;
+	ESlimeTransitionReason Reason = ESlimeTransitionReason::Other;
+};
+
+// Fixed size, lock-free ring of recent slime transitions. Recording never allocates or formats
+// strings, each record is also sent on the SlimeTransition trace channel for Unreal Insights
+// (enable with -trace=default,SlimeTransition)
+class UE_SOLO_PROJECT_API FSlimeTransitionLog
+{
+public:
+	static constexpr uint32 Capacity = 1024;
+
+	static void Record(const FSlimeTransitionRecord& Record);
+
+	// Copies the completed records, oldest first
+	static void Snapshot(TArray<FSlimeTransitionRecord>& OutRecords);
+
+private:
+	struct FSlot
+	{
+		// One past the write index of the record in the slot, zero while empty or being written
+		std::atomic<uint64> Sequence{ 0 };
+		FSlimeTransitionRecord Record;
+	};
+
+	static FSlot Slots[Capacity];
+	static std::atomic<uint64> WriteIndex;
+};
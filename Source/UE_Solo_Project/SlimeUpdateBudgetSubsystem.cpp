@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlimeUpdateBudgetSubsystem.h"
+
+#include "SlimeCharacter.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+void USlimeUpdateBudgetSubsystem::Register(ASlimeCharacter* Slime)
+{
+	if (!Slime) return;
+
+	Slimes.AddUnique(Slime);
+}
+
+void USlimeUpdateBudgetSubsystem::Unregister(ASlimeCharacter* Slime)
+{
+	Slimes.RemoveSwap(Slime);
+}
+
+void USlimeUpdateBudgetSubsystem::Tick(float DeltaTime)
+{
+	TimeUntilEvaluation -= DeltaTime;
+	if (TimeUntilEvaluation <= 0.0f)
+	{
+		TimeUntilEvaluation = EvaluationInterval;
+		EvaluateTiers();
+	}
+}
+
+TStatId USlimeUpdateBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USlimeUpdateBudgetSubsystem, STATGROUP_Tickables);
+}
+
+void USlimeUpdateBudgetSubsystem::EvaluateTiers()
+{
+	Slimes.RemoveAllSwap([](const TWeakObjectPtr<ASlimeCharacter>& Slime) { return !Slime.IsValid(); });
+
+	for (const TWeakObjectPtr<ASlimeCharacter>& Slime : Slimes)
+	{
+		Slime->SetUpdateTier(GetTier(Slime.Get()));
+	}
+}
+
+ESlimeUpdateTier USlimeUpdateBudgetSubsystem::GetTier(const ASlimeCharacter* Slime) const
+{
+	if (Slime->IsLocallyControlled() && Slime->IsPlayerControlled()) return ESlimeUpdateTier::Full;
+
+	const FVector Location = Slime->GetActorLocation();
+	const float Radius = Slime->GetCapsuleComponent()->GetScaledCapsuleRadius();
+	const bool IsRendered = Slime->WasRecentlyRendered(0.2f);
+
+	bool HasLocalView = false;
+	float ScreenSize = 0.0f;
+
+	//Largest the slime appears in any splitscreen player's view
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		if (!PlayerController || !PlayerController->IsLocalController()) continue;
+
+		HasLocalView = true;
+
+		if (const APawn* Pawn = PlayerController->GetPawn())
+		{
+			if (FVector::DistSquared(Pawn->GetActorLocation(), Location) < FMath::Square(FullUpdateDistance))
+			{
+				return ESlimeUpdateTier::Full;
+			}
+		}
+
+		if (!IsRendered || !PlayerController->PlayerCameraManager) continue;
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+		const FVector ToSlime = Location - ViewLocation;
+		const float Distance = ToSlime.Size();
+		const float HalfFOV = FMath::DegreesToRadians(PlayerController->PlayerCameraManager->GetFOVAngle() * 0.5f);
+
+		if (FVector::DotProduct(ViewRotation.Vector(), ToSlime / FMath::Max(Distance, 1.0f)) < FMath::Cos(HalfFOV)) continue;
+
+		ScreenSize = FMath::Max(ScreenSize, Radius / (FMath::Max(Distance, 1.0f) * FMath::Tan(HalfFOV)));
+	}
+
+	//A dedicated server has no views to budget by
+	if (!HasLocalView || ScreenSize >= FullUpdateScreenSize) return ESlimeUpdateTier::Full;
+
+	return ScreenSize >= MinVisibleScreenSize ? ESlimeUpdateTier::Reduced : ESlimeUpdateTier::Minimal;
+}
@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "SlimeUpdateBudgetSubsystem.generated.h"
+
+class ASlimeCharacter;
+
+UENUM()
+enum class ESlimeUpdateTier : uint8
+{
+	// Large or close in some local view, or driven by a local player
+	Full,
+	// Small in every view, probes and evaluates at a lower rate
+	Reduced,
+	// Off screen in every view, cosmetics stop until it is seen again
+	Minimal
+};
+
+namespace SlimeUpdateBudget
+{
+	// Frames between probe batches, also scales the state evaluation interval and distance
+	constexpr int32 GetFrameStride(const ESlimeUpdateTier Tier)
+	{
+		return Tier == ESlimeUpdateTier::Full ? 1 : Tier == ESlimeUpdateTier::Reduced ? 2 : 4;
+	}
+}
+
+// Splits the per frame slime budget between splitscreen views. Slimes are ranked by their
+// largest screen size across every local player's view, and ones that are small or off screen
+// in all of them update less often. Thresholds are read from the [/Script/UE_Solo_Project.SlimeUpdateBudgetSubsystem] section of DefaultGame.ini
+UCLASS(Config = Game)
+class UE_SOLO_PROJECT_API USlimeUpdateBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Slimes within this distance of a local player's slime always update fully
+	UPROPERTY(Config)
+	float FullUpdateDistance = 1500.0f;
+
+	// Fraction of a view's height a slime has to cover to update fully
+	UPROPERTY(Config)
+	float FullUpdateScreenSize = 0.08f;
+
+	// Visible slimes smaller than this are treated as off screen
+	UPROPERTY(Config)
+	float MinVisibleScreenSize = 0.01f;
+
+	// Seconds between re-ranking every slime
+	UPROPERTY(Config)
+	float EvaluationInterval = 0.25f;
+
+private:
+	TArray<TWeakObjectPtr<ASlimeCharacter>> Slimes;
+
+	float TimeUntilEvaluation = 0.0f;
+
+public:
+	void Register(ASlimeCharacter* Slime);
+
+	void Unregister(ASlimeCharacter* Slime);
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+private:
+	void EvaluateTiers();
+
+	ESlimeUpdateTier GetTier(const ASlimeCharacter* Slime) const;
+};
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SurfaceIndexBakeCommandlet.h"
+
+#include "SurfacePatchIndex.h"
+#include "SurfaceIndexSubsystem.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Misc/PackageName.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+#if WITH_EDITOR
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#endif
+
+USurfaceIndexBakeCommandlet::USurfaceIndexBakeCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USurfaceIndexBakeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString MapPath = TEXT("/Game/Maps/ThirdPersonMap");
+	FParse::Value(*Params, TEXT("Map="), MapPath);
+
+	UPackage* MapPackage = LoadPackage(nullptr, *MapPath, LOAD_None);
+	UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SurfaceIndexBake: could not load map %s"), *MapPath);
+		return 1;
+	}
+
+	World->AddToRoot();
+	World->WorldType = EWorldType::Editor;
+	World->InitWorld(UWorld::InitializationValues().AllowAudioPlayback(false).CreatePhysicsScene(false).RequiresHitProxies(false).CreateNavigation(false).CreateAISystem(false));
+	World->UpdateWorldComponents(true, false);
+
+	const FString MapName = FPackageName::GetShortName(MapPath);
+	const FString IndexPackagePath = USurfaceIndexSubsystem::GetIndexPackagePath(MapName);
+	const FString IndexName = FPackageName::GetShortName(IndexPackagePath);
+
+	UPackage* IndexPackage = CreatePackage(*IndexPackagePath);
+	USurfacePatchIndex* SurfaceIndex = NewObject<USurfacePatchIndex>(IndexPackage, *IndexName, RF_Public | RF_Standalone);
+
+	//World Partition maps only have their actors loaded on demand
+	if (UWorldPartition* WorldPartition = World->GetWorldPartition())
+	{
+		FWorldPartitionHelpers::ForEachActorWithLoading(WorldPartition, [this, SurfaceIndex](const FWorldPartitionActorDescInstance* ActorDescInstance)
+		{
+			BakeActor(ActorDescInstance->GetActor(), SurfaceIndex);
+			return true;
+		});
+	}
+	else
+	{
+		for (TActorIterator<AActor> Iterator(World); Iterator; ++Iterator)
+		{
+			BakeActor(*Iterator, SurfaceIndex);
+		}
+	}
+
+	IndexPackage->MarkPackageDirty();
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	const FString Filename = FPackageName::LongPackageNameToFilename(IndexPackagePath, FPackageName::GetAssetPackageExtension());
+	const bool Saved = UPackage::SavePackage(IndexPackage, SurfaceIndex, *Filename, SaveArgs);
+
+	UE_LOG(LogTemp, Display, TEXT("SurfaceIndexBake: %d patches from %d actors in %d cells -> %s"),
+		SurfaceIndex->Patches.Num(), SurfaceIndex->SourceActors.Num(), SurfaceIndex->Cells.Num(), *Filename);
+
+	World->CleanupWorld();
+	World->RemoveFromRoot();
+
+	return Saved ? 0 : 1;
+#else
+	return 1;
+#endif
+}
+
+void USurfaceIndexBakeCommandlet::BakeActor(AActor* Actor, USurfacePatchIndex* SurfaceIndex) const
+{
+	if (!Actor) return;
+
+	int32 SourceIndex = INDEX_NONE;
+
+	TInlineComponentArray<UPrimitiveComponent*> Components(Actor);
+	for (UPrimitiveComponent* Component : Components)
+	{
+		if (!Component->IsQueryCollisionEnabled() || Component->GetCollisionResponseToChannel(ECC_GameTraceChannel1) != ECR_Block) continue;
+
+		if (SourceIndex == INDEX_NONE)
+		{
+			SourceIndex = SurfaceIndex->SourceActors.Add(Actor);
+		}
+
+		const FTransform ComponentTransform = Component->GetComponentTransform();
+
+		//Simple collision boxes are baked exactly, anything else falls back to its local bounds
+		const UBodySetup* BodySetup = Component->GetBodySetup();
+		if (BodySetup && BodySetup->AggGeom.BoxElems.Num() > 0)
+		{
+			for (const FKBoxElem& Box : BodySetup->AggGeom.BoxElems)
+			{
+				const FTransform BoxTransform = Box.GetTransform() * ComponentTransform;
+				SurfaceIndex->AddBox(BoxTransform, FVector(Box.X, Box.Y, Box.Z) * 0.5f, SourceIndex);
+			}
+		}
+		else
+		{
+			const FBoxSphereBounds LocalBounds = Component->CalcLocalBounds();
+			const FTransform BoxTransform = FTransform(LocalBounds.Origin) * ComponentTransform;
+			SurfaceIndex->AddBox(BoxTransform, LocalBounds.BoxExtent, SourceIndex);
+		}
+	}
+}
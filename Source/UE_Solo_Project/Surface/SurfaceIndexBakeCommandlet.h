@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "SurfaceIndexBakeCommandlet.generated.h"
+
+class USurfacePatchIndex;
+
+// Bakes every ECC_GameTraceChannel1 blocking surface of a map into a USurfacePatchIndex
+// UnrealEditor-Cmd UE_Solo_Project -run=SurfaceIndexBake -Map=/Game/Maps/ThirdPersonMap
+UCLASS()
+class UE_SOLO_PROJECT_API USurfaceIndexBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USurfaceIndexBakeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	void BakeActor(AActor* Actor, USurfacePatchIndex* SurfaceIndex) const;
+};
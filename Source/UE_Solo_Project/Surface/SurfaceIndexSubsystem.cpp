@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SurfaceIndexSubsystem.h"
+
+#include "SurfacePatchIndex.h"
+
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+FString USurfaceIndexSubsystem::GetIndexPackagePath(const FString& MapName)
+{
+	return FString::Printf(TEXT("/Game/Data/SurfaceIndex/SI_%s"), *MapName);
+}
+
+void USurfaceIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &USurfaceIndexSubsystem::OnLevelStreamingChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &USurfaceIndexSubsystem::OnLevelStreamingChanged);
+}
+
+void USurfaceIndexSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	Super::Deinitialize();
+}
+
+bool USurfaceIndexSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USurfaceIndexSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const FString MapName = UWorld::RemovePIEPrefix(FPackageName::GetShortName(InWorld.GetOutermost()));
+	const FString PackagePath = GetIndexPackagePath(MapName);
+
+	if (FPackageName::DoesPackageExist(PackagePath))
+	{
+		SurfaceIndex = LoadObject<USurfacePatchIndex>(nullptr, *(PackagePath + TEXT(".") + FPackageName::GetShortName(PackagePath)));
+	}
+
+	if (SurfaceIndex)
+	{
+		RefreshEnabledSources();
+	}
+}
+
+bool USurfaceIndexSubsystem::HasIndex() const
+{
+	return SurfaceIndex != nullptr;
+}
+
+const USurfacePatchIndex* USurfaceIndexSubsystem::GetIndex() const
+{
+	return SurfaceIndex;
+}
+
+const TBitArray<>& USurfaceIndexSubsystem::GetEnabledSources() const
+{
+	return EnabledSources;
+}
+
+bool USurfaceIndexSubsystem::Raycast(const FVector& Start, const FVector& End, FHitResult& OutHit) const
+{
+	if (!SurfaceIndex) return false;
+
+	return SurfaceIndex->Raycast(Start, End, EnabledSources, OutHit);
+}
+
+void USurfaceIndexSubsystem::OnLevelStreamingChanged(ULevel* Level, UWorld* World)
+{
+	//Refreshed here rather than on the next raycast, raycasts can come from the parallel state update
+	if (World == GetWorld() && SurfaceIndex)
+	{
+		RefreshEnabledSources();
+	}
+}
+
+void USurfaceIndexSubsystem::RefreshEnabledSources()
+{
+	const int32 NumSources = SurfaceIndex->SourceActors.Num();
+	EnabledSources.Init(false, NumSources);
+
+#if WITH_EDITOR
+	//Baked paths name the editor level, PIE actors live in a UEDPIE_ prefixed copy of it
+	const int32 PIEInstanceID = GetWorld()->IsPlayInEditor() ? GetWorld()->GetOutermost()->GetPIEInstanceID() : INDEX_NONE;
+#endif
+
+	//A patch is live while the actor it was baked from is loaded
+	for (int32 SourceIndex = 0; SourceIndex < NumSources; ++SourceIndex)
+	{
+		FSoftObjectPath SourcePath = SurfaceIndex->SourceActors[SourceIndex].ToSoftObjectPath();
+#if WITH_EDITOR
+		if (PIEInstanceID != INDEX_NONE)
+		{
+			SourcePath.FixupForPIE(PIEInstanceID);
+		}
+#endif
+
+		const AActor* Actor = Cast<AActor>(SourcePath.ResolveObject());
+		EnabledSources[SourceIndex] = IsValid(Actor) && Actor->GetWorld() == GetWorld();
+	}
+
+	OnSourcesChanged.Broadcast();
+}
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "SurfaceIndexSubsystem.generated.h"
+
+class USurfacePatchIndex;
+
+DECLARE_MULTICAST_DELEGATE(FOnSurfaceSourcesChanged);
+
+// Loads the baked climbable-surface index for the current map and tracks which
+// parts of it are streamed in, so World Partition cells enable their patches as they load
+UCLASS()
+class UE_SOLO_PROJECT_API USurfaceIndexSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY()
+	TObjectPtr<USurfacePatchIndex> SurfaceIndex;
+
+	TBitArray<> EnabledSources;
+
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+
+public:
+	// Broadcast on the game thread after streaming enables or disables patches
+	FOnSurfaceSourcesChanged OnSourcesChanged;
+
+	// Where USurfaceIndexBakeCommandlet writes the index for a map
+	static FString GetIndexPackagePath(const FString& MapName);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	bool HasIndex() const;
+
+	const USurfacePatchIndex* GetIndex() const;
+
+	const TBitArray<>& GetEnabledSources() const;
+
+	// Only reads, so slimes deciding in parallel can share it
+	bool Raycast(const FVector& Start, const FVector& End, FHitResult& OutHit) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void OnLevelStreamingChanged(ULevel* Level, UWorld* World);
+
+	void RefreshEnabledSources();
+};
@@ -0,0 +1,288 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SurfaceNavGraph.h"
+
+#include "SurfacePatchIndex.h"
+
+#include "SlimeMovementStats.h"
+
+FSurfaceNavNodes::FSurfaceNavNodes(const USurfacePatchIndex& Index)
+	: CellSize(Index.CellSize)
+	, Patches(Index.Patches)
+{
+	Cells.Reserve(Index.Cells.Num());
+	for (const TPair<FIntVector, FSurfacePatchCell>& Cell : Index.Cells)
+	{
+		Cells.Add(Cell.Key, Cell.Value.PatchIndices);
+	}
+}
+
+FIntVector FSurfaceNavNodes::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
+
+FBox FSurfaceNavNodes::GetPatchBounds(const int32 PatchIndex) const
+{
+	const FSurfacePatch& Patch = Patches[PatchIndex];
+	const FVector Reach = FVector(Patch.AxisU).GetAbs() * Patch.Extents.X + FVector(Patch.AxisV).GetAbs() * Patch.Extents.Y;
+
+	return FBox(FVector(Patch.Center) - Reach, FVector(Patch.Center) + Reach);
+}
+
+FVector FSurfaceNavNodes::ClosestPointOnPatch(const int32 PatchIndex, const FVector& Location) const
+{
+	const FSurfacePatch& Patch = Patches[PatchIndex];
+	const FVector Center(Patch.Center);
+	const FVector AxisU(Patch.AxisU);
+	const FVector AxisV(Patch.AxisV);
+
+	const FVector Local = Location - Center;
+	const double U = FMath::Clamp(Local | AxisU, -Patch.Extents.X, Patch.Extents.X);
+	const double V = FMath::Clamp(Local | AxisV, -Patch.Extents.Y, Patch.Extents.Y);
+
+	return Center + AxisU * U + AxisV * V;
+}
+
+void FSurfaceNavNodes::GatherPatches(const FBox& Bounds, TArray<int32>& OutPatches) const
+{
+	const FIntVector MinCell = GetCell(Bounds.Min);
+	const FIntVector MaxCell = GetCell(Bounds.Max);
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				if (const TArray<int32>* Cell = Cells.Find(FIntVector(X, Y, Z)))
+				{
+					for (const int32 PatchIndex : *Cell)
+					{
+						OutPatches.AddUnique(PatchIndex);
+					}
+				}
+			}
+		}
+	}
+}
+
+FSurfaceNavGraph::FSurfaceNavGraph(const TSharedRef<const FSurfaceNavNodes, ESPMode::ThreadSafe>& InNodes, const TArray<TArray<FSurfaceNavEdge>>& NodeEdges, const TBitArray<>& EnabledSources)
+	: Nodes(InNodes)
+{
+	const int32 Count = Nodes->Patches.Num();
+
+	FirstEdge.SetNumUninitialized(Count + 1);
+	EnabledNodes.Init(false, Count);
+
+	int32 NumEdges = 0;
+	for (int32 Node = 0; Node < Count; ++Node)
+	{
+		NumEdges += NodeEdges.IsValidIndex(Node) ? NodeEdges[Node].Num() : 0;
+	}
+	Edges.Reserve(NumEdges);
+
+	for (int32 Node = 0; Node < Count; ++Node)
+	{
+		FirstEdge[Node] = Edges.Num();
+		if (NodeEdges.IsValidIndex(Node))
+		{
+			Edges.Append(NodeEdges[Node]);
+		}
+
+		const int32 SourceIndex = Nodes->Patches[Node].SourceIndex;
+		EnabledNodes[Node] = EnabledSources.IsValidIndex(SourceIndex) && EnabledSources[SourceIndex];
+	}
+	FirstEdge[Count] = Edges.Num();
+}
+
+int32 FSurfaceNavGraph::NumNodes() const
+{
+	return EnabledNodes.Num();
+}
+
+bool FSurfaceNavGraph::IsNodeEnabled(const int32 Node) const
+{
+	return EnabledNodes[Node];
+}
+
+int32 FSurfaceNavGraph::FindNearestNode(const FVector& Location, const float MaxDistance) const
+{
+	TArray<int32> Candidates;
+	Nodes->GatherPatches(FBox(Location, Location).ExpandBy(MaxDistance), Candidates);
+
+	int32 BestNode = INDEX_NONE;
+	double BestDistanceSquared = FMath::Square(MaxDistance);
+
+	for (const int32 Node : Candidates)
+	{
+		if (!IsNodeEnabled(Node)) continue;
+
+		const double DistanceSquared = FVector::DistSquared(Location, Nodes->ClosestPointOnPatch(Node, Location));
+		if (DistanceSquared <= BestDistanceSquared)
+		{
+			BestDistanceSquared = DistanceSquared;
+			BestNode = Node;
+		}
+	}
+
+	return BestNode;
+}
+
+bool FSurfaceNavGraph::FindPath(const FVector& Start, const FVector& Goal, FSurfaceNavPath& OutPath) const
+{
+	SLIME_MOVEMENT_SCOPE(SurfacePathQuery);
+
+	OutPath.Points.Reset();
+
+	//Slimes sit about a capsule radius off the surface they are on
+	const float SnapDistance = 200.0f;
+
+	const int32 StartNode = FindNearestNode(Start, SnapDistance);
+	const int32 GoalNode = FindNearestNode(Goal, SnapDistance);
+	if (StartNode == INDEX_NONE || GoalNode == INDEX_NONE) return false;
+
+	const int32 Count = NumNodes();
+	const TArray<FSurfacePatch>& Patches = Nodes->Patches;
+	const FVector GoalCenter(Patches[GoalNode].Center);
+
+	TArray<float> Costs;
+	Costs.Init(TNumericLimits<float>::Max(), Count);
+
+	//Node and edge each node was reached through
+	TArray<int32> ReachedFrom;
+	ReachedFrom.Init(INDEX_NONE, Count);
+	TArray<int32> ReachedBy;
+	ReachedBy.Init(INDEX_NONE, Count);
+
+	TBitArray<> Closed(false, Count);
+
+	using FOpenNode = TPair<float, int32>;
+	TArray<FOpenNode> Open;
+	const auto Cheapest = [](const FOpenNode& A, const FOpenNode& B) { return A.Key < B.Key; };
+
+	Costs[StartNode] = 0.0f;
+	Open.HeapPush(FOpenNode(FVector::Dist(FVector(Patches[StartNode].Center), GoalCenter), StartNode), Cheapest);
+
+	while (Open.Num() > 0)
+	{
+		FOpenNode Current;
+		Open.HeapPop(Current, Cheapest, EAllowShrinking::No);
+
+		const int32 Node = Current.Value;
+		if (Closed[Node]) continue;
+		Closed[Node] = true;
+
+		if (Node == GoalNode) break;
+
+		for (int32 EdgeIndex = FirstEdge[Node]; EdgeIndex < FirstEdge[Node + 1]; ++EdgeIndex)
+		{
+			const FSurfaceNavEdge& Edge = Edges[EdgeIndex];
+			if (Closed[Edge.ToNode] || !IsNodeEnabled(Edge.ToNode)) continue;
+
+			const float Cost = Costs[Node] + Edge.Cost;
+			if (Cost >= Costs[Edge.ToNode]) continue;
+
+			Costs[Edge.ToNode] = Cost;
+			ReachedFrom[Edge.ToNode] = Node;
+			ReachedBy[Edge.ToNode] = EdgeIndex;
+
+			const float Heuristic = FVector::Dist(FVector(Patches[Edge.ToNode].Center), GoalCenter);
+			Open.HeapPush(FOpenNode(Cost + Heuristic, Edge.ToNode), Cheapest);
+		}
+	}
+
+	if (!Closed[GoalNode]) return false;
+
+	//Walk back from the goal
+	TArray<int32> PathNodes;
+	for (int32 Node = GoalNode; Node != StartNode; Node = ReachedFrom[Node])
+	{
+		PathNodes.Add(Node);
+	}
+
+	for (int32 Index = PathNodes.Num() - 1; Index >= 0; --Index)
+	{
+		const int32 Node = PathNodes[Index];
+		const FSurfaceNavEdge& Edge = Edges[ReachedBy[Node]];
+		const FVector EntryNormal(Patches[Node].Normal);
+
+		if (Edge.Link == ESurfaceNavLink::Jump)
+		{
+			OutPath.Points.Add({ FVector(Edge.Exit), FVector(Patches[ReachedFrom[Node]].Normal), ESurfaceNavLink::Walk });
+		}
+		OutPath.Points.Add({ FVector(Edge.Entry), EntryNormal, Edge.Link });
+	}
+
+	OutPath.Points.Add({ Nodes->ClosestPointOnPatch(GoalNode, Goal), FVector(Patches[GoalNode].Normal), ESurfaceNavLink::Walk });
+	return true;
+}
+
+namespace SurfaceNavBuild
+{
+	void LinkPatch(const FSurfaceNavNodes& Nodes, const int32 PatchIndex, const FSurfaceNavBuildSettings& Settings, TArray<FSurfaceNavEdge>& OutEdges)
+	{
+		OutEdges.Reset();
+
+		const FSurfacePatch& Patch = Nodes.Patches[PatchIndex];
+		const FVector Center(Patch.Center);
+		const FVector Normal(Patch.Normal);
+
+		TArray<int32> Candidates;
+		Nodes.GatherPatches(Nodes.GetPatchBounds(PatchIndex).ExpandBy(Settings.MaxJumpDistance), Candidates);
+
+		for (const int32 OtherIndex : Candidates)
+		{
+			if (OtherIndex == PatchIndex) continue;
+
+			const FSurfacePatch& Other = Nodes.Patches[OtherIndex];
+			const FVector OtherCenter(Other.Center);
+			const FVector OtherNormal(Other.Normal);
+
+			//Back to back faces never connect
+			if ((Normal | OtherNormal) < -0.9) continue;
+
+			//Closest points between the two rectangles, alternating projections settles in a few steps
+			FVector Exit = Nodes.ClosestPointOnPatch(PatchIndex, OtherCenter);
+			FVector Entry = Nodes.ClosestPointOnPatch(OtherIndex, Exit);
+			for (int32 Step = 0; Step < 3; ++Step)
+			{
+				Exit = Nodes.ClosestPointOnPatch(PatchIndex, Entry);
+				Entry = Nodes.ClosestPointOnPatch(OtherIndex, Exit);
+			}
+
+			const double Gap = FVector::Dist(Exit, Entry);
+			if (Gap > Settings.MaxJumpDistance) continue;
+
+			FSurfaceNavEdge Edge;
+			Edge.ToNode = OtherIndex;
+			Edge.Exit = FVector3f(Exit);
+			Edge.Entry = FVector3f(Entry);
+
+			const double Approach = FVector::Dist(Center, Exit) + FVector::Dist(Entry, OtherCenter);
+
+			if (Gap <= Settings.LinkTolerance)
+			{
+				//Convex edges put the other patch behind this one
+				const bool Convex = (Normal | (OtherCenter - Center)) < -Settings.LinkTolerance;
+
+				Edge.Link = Convex ? ESurfaceNavLink::WrapAround : ESurfaceNavLink::Walk;
+				Edge.Cost = Approach * (Convex ? Settings.WrapAroundCostScale : 1.0f);
+			}
+			else
+			{
+				//Jumps have to leave from the front of this patch and land on the front of the other
+				const FVector Direction = (Entry - Exit) / Gap;
+				if ((Normal | Direction) < 0.0 || (OtherNormal | Direction) > 0.0) continue;
+
+				Edge.Link = ESurfaceNavLink::Jump;
+				Edge.Cost = Approach + Gap * Settings.JumpCostScale;
+			}
+
+			OutEdges.Add(Edge);
+		}
+	}
+}
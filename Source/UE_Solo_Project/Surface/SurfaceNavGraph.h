@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USurfacePatchIndex;
+struct FSurfacePatch;
+
+// How a slime gets from one patch to the next
+enum class ESurfaceNavLink : uint8
+{
+	Walk,
+	// Around a convex edge onto the far side, the same move HasPlayerFoundWrapAroundSurface makes
+	WrapAround,
+	Jump,
+};
+
+struct FSurfaceNavEdge
+{
+	int32 ToNode = INDEX_NONE;
+	float Cost = 0.0f;
+	ESurfaceNavLink Link = ESurfaceNavLink::Walk;
+
+	// Where the slime leaves this patch and arrives on the next one
+	FVector3f Exit = FVector3f::ZeroVector;
+	FVector3f Entry = FVector3f::ZeroVector;
+};
+
+struct FSurfaceNavBuildSettings
+{
+	// Patches closer than this are walked between
+	float LinkTolerance = 20.0f;
+
+	// Furthest gap a charged jump is expected to clear
+	float MaxJumpDistance = 600.0f;
+
+	float WrapAroundCostScale = 1.25f;
+	float JumpCostScale = 2.0f;
+};
+
+struct FSurfaceNavPathPoint
+{
+	FVector Location = FVector::ZeroVector;
+	FVector Normal = FVector::UpVector;
+
+	// Link taken to reach this point
+	ESurfaceNavLink Link = ESurfaceNavLink::Walk;
+};
+
+struct FSurfaceNavPath
+{
+	TArray<FSurfaceNavPathPoint> Points;
+
+	bool IsValid() const { return Points.Num() > 0; }
+};
+
+// Patch geometry and the grid it was baked into, copied once so queries never touch the UObject index
+struct FSurfaceNavNodes
+{
+	float CellSize = 1000.0f;
+	TArray<FSurfacePatch> Patches;
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	explicit FSurfaceNavNodes(const USurfacePatchIndex& Index);
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	FBox GetPatchBounds(const int32 PatchIndex) const;
+
+	FVector ClosestPointOnPatch(const int32 PatchIndex, const FVector& Location) const;
+
+	void GatherPatches(const FBox& Bounds, TArray<int32>& OutPatches) const;
+};
+
+// Immutable snapshot of the surface graph. Path queries hold a shared reference,
+// so a rebuild publishes a new snapshot instead of touching one a query might be reading
+class UE_SOLO_PROJECT_API FSurfaceNavGraph
+{
+private:
+	TSharedRef<const FSurfaceNavNodes, ESPMode::ThreadSafe> Nodes;
+
+	//Edges of node N are Edges[FirstEdge[N] .. FirstEdge[N + 1])
+	TArray<int32> FirstEdge;
+	TArray<FSurfaceNavEdge> Edges;
+
+	TBitArray<> EnabledNodes;
+
+public:
+	FSurfaceNavGraph(const TSharedRef<const FSurfaceNavNodes, ESPMode::ThreadSafe>& InNodes, const TArray<TArray<FSurfaceNavEdge>>& NodeEdges, const TBitArray<>& EnabledSources);
+
+	int32 NumNodes() const;
+
+	// Closest enabled patch to a location, INDEX_NONE if none is within MaxDistance
+	int32 FindNearestNode(const FVector& Location, const float MaxDistance) const;
+
+	// A* from the patch nearest Start to the patch nearest Goal, safe to run on any thread
+	bool FindPath(const FVector& Start, const FVector& Goal, FSurfaceNavPath& OutPath) const;
+
+private:
+	bool IsNodeEnabled(const int32 Node) const;
+};
+
+// Works out the links leaving a patch to every patch around it, loaded or not, so it only needs doing once
+namespace SurfaceNavBuild
+{
+	void LinkPatch(const FSurfaceNavNodes& Nodes, const int32 PatchIndex, const FSurfaceNavBuildSettings& Settings, TArray<FSurfaceNavEdge>& OutEdges);
+}
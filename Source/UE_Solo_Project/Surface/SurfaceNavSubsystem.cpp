@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SurfaceNavSubsystem.h"
+
+#include "SurfaceIndexSubsystem.h"
+#include "SurfacePatchIndex.h"
+
+#include "SlimeMovementStats.h"
+
+#include "Async/Async.h"
+
+void USurfaceNavSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	USurfaceIndexSubsystem* SurfaceIndex = Collection.InitializeDependency<USurfaceIndexSubsystem>();
+	if (SurfaceIndex)
+	{
+		SourcesChangedHandle = SurfaceIndex->OnSourcesChanged.AddUObject(this, &USurfaceNavSubsystem::OnSourcesChanged);
+	}
+}
+
+void USurfaceNavSubsystem::Deinitialize()
+{
+	if (USurfaceIndexSubsystem* SurfaceIndex = GetWorld()->GetSubsystem<USurfaceIndexSubsystem>())
+	{
+		SurfaceIndex->OnSourcesChanged.Remove(SourcesChangedHandle);
+	}
+
+	//Queries still running keep their own reference to the graph
+	Graph.Reset();
+	Nodes.Reset();
+
+	Super::Deinitialize();
+}
+
+bool USurfaceNavSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TSharedPtr<const FSurfaceNavGraph, ESPMode::ThreadSafe> USurfaceNavSubsystem::GetGraph() const
+{
+	return Graph;
+}
+
+void USurfaceNavSubsystem::FindPathAsync(const FVector& Start, const FVector& Goal, FOnSurfacePathFound OnPathFound) const
+{
+	TSharedPtr<const FSurfaceNavGraph, ESPMode::ThreadSafe> Snapshot = Graph;
+	if (!Snapshot)
+	{
+		OnPathFound.ExecuteIfBound(FSurfaceNavPath());
+		return;
+	}
+
+	Async(EAsyncExecution::ThreadPool, [Snapshot, Start, Goal, OnPathFound = MoveTemp(OnPathFound)]() mutable
+	{
+		FSurfaceNavPath Path;
+		Snapshot->FindPath(Start, Goal, Path);
+
+		//Delegates bound to a UObject are skipped if it was destroyed while the query ran
+		AsyncTask(ENamedThreads::GameThread, [Path = MoveTemp(Path), OnPathFound = MoveTemp(OnPathFound)]()
+		{
+			OnPathFound.ExecuteIfBound(Path);
+		});
+	});
+}
+
+void USurfaceNavSubsystem::OnSourcesChanged()
+{
+	SLIME_MOVEMENT_SCOPE(SurfaceGraphRebuild);
+
+	const USurfaceIndexSubsystem* SurfaceIndex = GetWorld()->GetSubsystem<USurfaceIndexSubsystem>();
+	if (!SurfaceIndex || !SurfaceIndex->HasIndex()) return;
+
+	if (!Nodes)
+	{
+		Nodes = MakeShared<FSurfaceNavNodes, ESPMode::ThreadSafe>(*SurfaceIndex->GetIndex());
+		NodeEdges.SetNum(Nodes->Patches.Num());
+		LinkedNodes.Init(false, Nodes->Patches.Num());
+	}
+
+	//Only patches streaming in for the first time need linking, links to patches that
+	//are still unloaded were already made and start being followed once they load
+	const TBitArray<>& EnabledSources = SurfaceIndex->GetEnabledSources();
+	for (int32 Node = 0; Node < Nodes->Patches.Num(); ++Node)
+	{
+		if (LinkedNodes[Node]) continue;
+
+		const int32 SourceIndex = Nodes->Patches[Node].SourceIndex;
+		if (!EnabledSources.IsValidIndex(SourceIndex) || !EnabledSources[SourceIndex]) continue;
+
+		SurfaceNavBuild::LinkPatch(*Nodes, Node, BuildSettings, NodeEdges[Node]);
+		LinkedNodes[Node] = true;
+	}
+
+	Graph = MakeShared<FSurfaceNavGraph, ESPMode::ThreadSafe>(Nodes.ToSharedRef(), NodeEdges, EnabledSources);
+}
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "SurfaceNavGraph.h"
+
+#include "SurfaceNavSubsystem.generated.h"
+
+class USurfaceIndexSubsystem;
+
+DECLARE_DELEGATE_OneParam(FOnSurfacePathFound, const FSurfaceNavPath&);
+
+// Navigation over climbable walls and ceilings, which navmesh doesn't cover. Links patches
+// of the baked surface index as their World Partition cells stream in and answers path
+// queries on the thread pool against the latest published graph
+UCLASS()
+class UE_SOLO_PROJECT_API USurfaceNavSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	FSurfaceNavBuildSettings BuildSettings;
+
+	TSharedPtr<const FSurfaceNavNodes, ESPMode::ThreadSafe> Nodes;
+
+	//Links leaving each patch, worked out the first time the patch streams in
+	TArray<TArray<FSurfaceNavEdge>> NodeEdges;
+	TBitArray<> LinkedNodes;
+
+	TSharedPtr<const FSurfaceNavGraph, ESPMode::ThreadSafe> Graph;
+
+	FDelegateHandle SourcesChangedHandle;
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	TSharedPtr<const FSurfaceNavGraph, ESPMode::ThreadSafe> GetGraph() const;
+
+	// Runs A* on the thread pool, OnPathFound is called on the game thread with an empty path on failure
+	void FindPathAsync(const FVector& Start, const FVector& Goal, FOnSurfacePathFound OnPathFound) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void OnSourcesChanged();
+};
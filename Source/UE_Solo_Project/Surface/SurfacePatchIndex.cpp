@@ -0,0 +1,219 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SurfacePatchIndex.h"
+
+#include "Engine/HitResult.h"
+#include "Math/VectorRegister.h"
+
+void USurfacePatchIndex::AddPatch(const FSurfacePatch& Patch)
+{
+	const int32 PatchIndex = Patches.Add(Patch);
+
+	//Register the patch with every cell its bounds touch
+	const FVector Center(Patch.Center);
+	const FVector Reach = FVector(Patch.AxisU).GetAbs() * Patch.Extents.X + FVector(Patch.AxisV).GetAbs() * Patch.Extents.Y;
+
+	const FIntVector MinCell = GetCell(Center - Reach);
+	const FIntVector MaxCell = GetCell(Center + Reach);
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				Cells.FindOrAdd(FIntVector(X, Y, Z)).PatchIndices.Add(PatchIndex);
+				AddToBatches(FIntVector(X, Y, Z), PatchIndex);
+			}
+		}
+	}
+}
+
+void USurfacePatchIndex::AddBox(const FTransform& BoxTransform, const FVector& HalfExtents, const int32 SourceIndex)
+{
+	const FVector Scale = BoxTransform.GetScale3D().GetAbs();
+	const FVector Extents = HalfExtents * Scale;
+	const FQuat Rotation = BoxTransform.GetRotation();
+	const FVector Center = BoxTransform.GetLocation();
+
+	const FVector Axes[3] = { Rotation.GetAxisX(), Rotation.GetAxisY(), Rotation.GetAxisZ() };
+
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		const int32 AxisU = (Axis + 1) % 3;
+		const int32 AxisV = (Axis + 2) % 3;
+
+		for (const float Side : { 1.0f, -1.0f })
+		{
+			FSurfacePatch Patch;
+			Patch.Center = FVector3f(Center + Axes[Axis] * Extents[Axis] * Side);
+			Patch.Normal = FVector3f(Axes[Axis] * Side);
+			Patch.AxisU = FVector3f(Axes[AxisU]);
+			Patch.AxisV = FVector3f(Axes[AxisV]);
+			Patch.Extents = FVector2f(Extents[AxisU], Extents[AxisV]);
+			Patch.SourceIndex = SourceIndex;
+
+			AddPatch(Patch);
+		}
+	}
+}
+
+namespace SurfacePatchMath
+{
+	FORCEINLINE VectorRegister4Float Dot3(
+		const VectorRegister4Float& AX, const VectorRegister4Float& AY, const VectorRegister4Float& AZ,
+		const VectorRegister4Float& BX, const VectorRegister4Float& BY, const VectorRegister4Float& BZ)
+	{
+		return VectorMultiplyAdd(AZ, BZ, VectorMultiplyAdd(AY, BY, VectorMultiply(AX, BX)));
+	}
+}
+
+bool USurfacePatchIndex::Raycast(const FVector& Start, const FVector& End, const TBitArray<>& EnabledSources, FHitResult& OutHit) const
+{
+	using namespace SurfacePatchMath;
+
+	const FVector3f Start3f(Start);
+	const FVector3f Delta3f(End - Start);
+
+	//The ray is splatted across lanes, each lane holds a different patch
+	const VectorRegister4Float OriginX = VectorSetFloat1(Start3f.X);
+	const VectorRegister4Float OriginY = VectorSetFloat1(Start3f.Y);
+	const VectorRegister4Float OriginZ = VectorSetFloat1(Start3f.Z);
+	const VectorRegister4Float DirectionX = VectorSetFloat1(Delta3f.X);
+	const VectorRegister4Float DirectionY = VectorSetFloat1(Delta3f.Y);
+	const VectorRegister4Float DirectionZ = VectorSetFloat1(Delta3f.Z);
+	const VectorRegister4Float Zero = VectorZeroFloat();
+
+	float BestTime = 1.0f;
+	int32 BestPatch = INDEX_NONE;
+
+	const FIntVector MinCell = GetCell(Start.ComponentMin(End));
+	const FIntVector MaxCell = GetCell(Start.ComponentMax(End));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const TArray<FSurfacePatchBatch>* Batches = CellBatches.Find(FIntVector(X, Y, Z));
+				if (!Batches) continue;
+
+				for (const FSurfacePatchBatch& Batch : *Batches)
+				{
+					const VectorRegister4Float NormalX = VectorLoadAligned(Batch.NormalX);
+					const VectorRegister4Float NormalY = VectorLoadAligned(Batch.NormalY);
+					const VectorRegister4Float NormalZ = VectorLoadAligned(Batch.NormalZ);
+
+					const VectorRegister4Float ToCenterX = VectorSubtract(VectorLoadAligned(Batch.CenterX), OriginX);
+					const VectorRegister4Float ToCenterY = VectorSubtract(VectorLoadAligned(Batch.CenterY), OriginY);
+					const VectorRegister4Float ToCenterZ = VectorSubtract(VectorLoadAligned(Batch.CenterZ), OriginZ);
+
+					//Only surfaces facing the ray can be landed on, which also rules out empty lanes
+					const VectorRegister4Float Facing = Dot3(NormalX, NormalY, NormalZ, DirectionX, DirectionY, DirectionZ);
+					const VectorRegister4Float Time = VectorDivide(Dot3(NormalX, NormalY, NormalZ, ToCenterX, ToCenterY, ToCenterZ), Facing);
+
+					VectorRegister4Float Mask = VectorBitwiseAnd(VectorCompareLT(Facing, Zero), VectorCompareGE(Time, Zero));
+					Mask = VectorBitwiseAnd(Mask, VectorCompareLT(Time, VectorSetFloat1(BestTime)));
+					if (VectorMaskBits(Mask) == 0) continue;
+
+					//Inside the rectangle
+					const VectorRegister4Float LocalX = VectorSubtract(VectorMultiply(DirectionX, Time), ToCenterX);
+					const VectorRegister4Float LocalY = VectorSubtract(VectorMultiply(DirectionY, Time), ToCenterY);
+					const VectorRegister4Float LocalZ = VectorSubtract(VectorMultiply(DirectionZ, Time), ToCenterZ);
+
+					const VectorRegister4Float U = VectorAbs(Dot3(LocalX, LocalY, LocalZ, VectorLoadAligned(Batch.AxisUX), VectorLoadAligned(Batch.AxisUY), VectorLoadAligned(Batch.AxisUZ)));
+					const VectorRegister4Float V = VectorAbs(Dot3(LocalX, LocalY, LocalZ, VectorLoadAligned(Batch.AxisVX), VectorLoadAligned(Batch.AxisVY), VectorLoadAligned(Batch.AxisVZ)));
+
+					Mask = VectorBitwiseAnd(Mask, VectorCompareLE(U, VectorLoadAligned(Batch.ExtentU)));
+					Mask = VectorBitwiseAnd(Mask, VectorCompareLE(V, VectorLoadAligned(Batch.ExtentV)));
+
+					uint32 Lanes = VectorMaskBits(Mask);
+					if (Lanes == 0) continue;
+
+					alignas(16) float Times[4];
+					VectorStoreAligned(Time, Times);
+
+					//Few lanes survive, so streaming checks and picking the closest stay scalar
+					for (; Lanes != 0; Lanes &= Lanes - 1)
+					{
+						const int32 Lane = static_cast<int32>(FMath::CountTrailingZeros(Lanes));
+						const int32 SourceIndex = Batch.SourceIndices[Lane];
+						if (!EnabledSources.IsValidIndex(SourceIndex) || !EnabledSources[SourceIndex]) continue;
+						if (Times[Lane] >= BestTime) continue;
+
+						BestTime = Times[Lane];
+						BestPatch = Batch.PatchIndices[Lane];
+					}
+				}
+			}
+		}
+	}
+
+	if (BestPatch == INDEX_NONE) return false;
+
+	const FVector HitLocation = Start + (End - Start) * BestTime;
+	const FVector HitNormal(Patches[BestPatch].Normal);
+
+	OutHit = FHitResult(Start, End);
+	OutHit.bBlockingHit = true;
+	OutHit.Time = BestTime;
+	OutHit.Distance = (End - Start).Size() * BestTime;
+	OutHit.Location = HitLocation;
+	OutHit.ImpactPoint = HitLocation;
+	OutHit.Normal = HitNormal;
+	OutHit.ImpactNormal = HitNormal;
+	return true;
+}
+
+FIntVector USurfacePatchIndex::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
+
+void USurfacePatchIndex::PostLoad()
+{
+	Super::PostLoad();
+
+	CellBatches.Reset();
+	for (const TPair<FIntVector, FSurfacePatchCell>& Cell : Cells)
+	{
+		for (const int32 PatchIndex : Cell.Value.PatchIndices)
+		{
+			AddToBatches(Cell.Key, PatchIndex);
+		}
+	}
+}
+
+void USurfacePatchIndex::AddToBatches(const FIntVector& Cell, const int32 PatchIndex)
+{
+	TArray<FSurfacePatchBatch>& Batches = CellBatches.FindOrAdd(Cell);
+	if (Batches.Num() == 0 || Batches.Last().Num == 4)
+	{
+		Batches.AddDefaulted();
+	}
+
+	FSurfacePatchBatch& Batch = Batches.Last();
+	const int32 Lane = Batch.Num++;
+	const FSurfacePatch& Patch = Patches[PatchIndex];
+
+	Batch.CenterX[Lane] = Patch.Center.X;
+	Batch.CenterY[Lane] = Patch.Center.Y;
+	Batch.CenterZ[Lane] = Patch.Center.Z;
+	Batch.NormalX[Lane] = Patch.Normal.X;
+	Batch.NormalY[Lane] = Patch.Normal.Y;
+	Batch.NormalZ[Lane] = Patch.Normal.Z;
+	Batch.AxisUX[Lane] = Patch.AxisU.X;
+	Batch.AxisUY[Lane] = Patch.AxisU.Y;
+	Batch.AxisUZ[Lane] = Patch.AxisU.Z;
+	Batch.AxisVX[Lane] = Patch.AxisV.X;
+	Batch.AxisVY[Lane] = Patch.AxisV.Y;
+	Batch.AxisVZ[Lane] = Patch.AxisV.Z;
+	Batch.ExtentU[Lane] = Patch.Extents.X;
+	Batch.ExtentV[Lane] = Patch.Extents.Y;
+	Batch.PatchIndices[Lane] = PatchIndex;
+	Batch.SourceIndices[Lane] = Patch.SourceIndex;
+}
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Math/VectorRegister.h"
+
+#include "SurfacePatchIndex.generated.h"
+
+// One flat, oriented rectangle of climbable geometry
+USTRUCT()
+struct FSurfacePatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector3f Center = FVector3f::ZeroVector;
+
+	UPROPERTY()
+	FVector3f Normal = FVector3f::UpVector;
+
+	UPROPERTY()
+	FVector3f AxisU = FVector3f::ForwardVector;
+
+	UPROPERTY()
+	FVector3f AxisV = FVector3f::RightVector;
+
+	// Half size along AxisU and AxisV
+	UPROPERTY()
+	FVector2f Extents = FVector2f::ZeroVector;
+
+	// Index into USurfacePatchIndex::SourceActors
+	UPROPERTY()
+	int32 SourceIndex = INDEX_NONE;
+};
+
+USTRUCT()
+struct FSurfacePatchCell
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<int32> PatchIndices;
+};
+
+// Up to four patches of one cell stored component by component, so a ray is tested against all of them at once.
+// Unused lanes have negative extents and a zero normal, which never pass the facing test
+struct alignas(16) FSurfacePatchBatch
+{
+	float CenterX[4] = {};
+	float CenterY[4] = {};
+	float CenterZ[4] = {};
+	float NormalX[4] = {};
+	float NormalY[4] = {};
+	float NormalZ[4] = {};
+	float AxisUX[4] = {};
+	float AxisUY[4] = {};
+	float AxisUZ[4] = {};
+	float AxisVX[4] = {};
+	float AxisVY[4] = {};
+	float AxisVZ[4] = {};
+	float ExtentU[4] = { -1.0f, -1.0f, -1.0f, -1.0f };
+	float ExtentV[4] = { -1.0f, -1.0f, -1.0f, -1.0f };
+	int32 PatchIndices[4] = { INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE };
+	int32 SourceIndices[4] = { INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE };
+	int32 Num = 0;
+};
+
+// Climbable surfaces of a map baked into a uniform grid, built by USurfaceIndexBakeCommandlet
+UCLASS(BlueprintType)
+class UE_SOLO_PROJECT_API USurfacePatchIndex : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, Category = "Surface Index")
+	float CellSize = 1000.0f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Surface Index")
+	TArray<FSurfacePatch> Patches;
+
+	UPROPERTY()
+	TMap<FIntVector, FSurfacePatchCell> Cells;
+
+	// Actors the patches were baked from, patches are only hit while their actor is streamed in
+	UPROPERTY(VisibleAnywhere, Category = "Surface Index")
+	TArray<TSoftObjectPtr<AActor>> SourceActors;
+
+public:
+	void AddPatch(const FSurfacePatch& Patch);
+
+	// Adds the six faces of an oriented box
+	void AddBox(const FTransform& BoxTransform, const FVector& HalfExtents, const int32 SourceIndex);
+
+	// Closest patch facing the segment, only considering patches whose source is enabled
+	bool Raycast(const FVector& Start, const FVector& End, const TBitArray<>& EnabledSources, FHitResult& OutHit) const;
+
+	virtual void PostLoad() override;
+
+private:
+	// Cells repacked four patches at a time for Raycast, rebuilt on load rather than saved
+	TMap<FIntVector, TArray<FSurfacePatchBatch>> CellBatches;
+
+private:
+	FIntVector GetCell(const FVector& Location) const;
+
+	void AddToBatches(const FIntVector& Cell, const int32 PatchIndex);
+};
@@ -8,7 +8,7 @@ public class UE_Solo_Project : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 	
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "TraceLog", "AIModule", "MassEntity", "MassCommon", "MassSpawner" });
 
 		PrivateDependencyModuleNames.AddRange(new string[] {  });
 